@@ -0,0 +1,204 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+// The non-SAT work done around the oracle calls: duplicating the formula,
+// adding the indicator clauses, and building the assumptions of the
+// backward, forward and guess engines, at growing numbers of variables and
+// group sizes. The formula is a random 3-CNF over all sampling variables.
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "microbench.h"
+#include "common.h"
+#include "graphgen.h"
+
+using std::vector;
+
+namespace {
+
+void add_random_cnf(Common& comm, uint32_t num_vars)
+{
+    GraphGen::Rand rnd(num_vars);
+    const uint64_t num_cls = (uint64_t)num_vars*42/10;
+    vector<Lit> cl;
+    for(uint64_t i = 0; i < num_cls; i++) {
+        cl.clear();
+        for(uint32_t j = 0; j < 3; j++) {
+            cl.push_back(Lit(rnd.below(num_vars), rnd.below(2)));
+        }
+        comm.solver->add_clause(cl);
+    }
+}
+
+// All variables are sampling variables, in consecutive groups of group_size
+// (no groups if group_size is 0)
+void set_up_vars(Common& comm, uint32_t num_vars, uint32_t group_size)
+{
+    comm.conf.verb = 0;
+    comm.conf.group_indep = group_size > 0;
+    comm.solver->set_verbosity(0);
+    comm.solver->new_vars(num_vars);
+    comm.orig_num_vars = num_vars;
+    comm.sampling_set->clear();
+    for(uint32_t v = 0; v < num_vars; v++) comm.sampling_set->push_back(v);
+
+    comm.var2var_group.assign(num_vars, 0);
+    comm.var_groups.clear();
+    comm.var_groups.push_back(vector<uint32_t>());
+    if (group_size == 0) return;
+    for(uint32_t v = 0; v < num_vars; v++) {
+        if (v % group_size == 0) comm.var_groups.push_back(vector<uint32_t>());
+        comm.var_groups.back().push_back(v);
+        comm.var2var_group[v] = comm.var_groups.size()-1;
+    }
+}
+
+void BM_duplicate_problem(MicroBench::State& state)
+{
+    const uint32_t num_vars = state.range(0);
+    uint64_t cls = 0;
+    for (auto _ : state) {
+        state.pause_timing();
+        std::unique_ptr<Common> comm(new Common);
+        set_up_vars(*comm, num_vars, 0);
+        add_random_cnf(*comm, num_vars);
+        cls += (uint64_t)num_vars*42/10;
+        state.resume_timing();
+
+        comm->duplicate_problem();
+
+        state.pause_timing();
+        comm.reset();
+        state.resume_timing();
+    }
+    state.set_items_processed(cls);
+}
+MICROBENCH(BM_duplicate_problem)->arg(1000)->arg(10*1000)->arg(100*1000);
+
+void BM_add_fixed_clauses(MicroBench::State& state)
+{
+    const uint32_t num_vars = state.range(0);
+    for (auto _ : state) {
+        state.pause_timing();
+        std::unique_ptr<Common> comm(new Common);
+        set_up_vars(*comm, num_vars, 0);
+        comm->solver->new_vars(num_vars);
+        state.resume_timing();
+
+        comm->add_fixed_clauses();
+
+        state.pause_timing();
+        comm.reset();
+        state.resume_timing();
+    }
+    state.set_items_processed(state.iterations()*num_vars);
+}
+MICROBENCH(BM_add_fixed_clauses)->arg(1000)->arg(10*1000)->arg(100*1000);
+
+// Indicators added, half of the groups already known to be independent and
+// the other half still unknown, as in the middle of a round
+struct Fixture
+{
+    Fixture(uint32_t num_vars, uint32_t group_size)
+    {
+        set_up_vars(comm, num_vars, group_size);
+        comm.solver->new_vars(num_vars);
+        comm.add_fixed_clauses();
+        comm.seen.assign(comm.solver->nVars(), 0);
+
+        const uint32_t half = group_size == 0 ? num_vars/2
+            : (num_vars/2)/group_size*group_size;
+        for(uint32_t v = 0; v < num_vars; v++) {
+            if (v < half) indep.push_back(v);
+            else unknown.push_back(v);
+        }
+        unknown_set.assign(num_vars, 0);
+        for(const auto v: unknown) unknown_set[v] = 1;
+        guess_set.assign(num_vars, 1);
+        dontremove_vars.assign(num_vars, 0);
+    }
+
+    Common comm;
+    vector<uint32_t> indep;
+    vector<uint32_t> unknown;
+    vector<char> unknown_set;
+    vector<char> guess_set;
+    vector<char> dontremove_vars;
+    vector<Lit> assumptions;
+};
+
+Fixture& get_fixture(uint32_t num_vars, uint32_t group_size)
+{
+    static std::map<std::pair<uint32_t, uint32_t>, std::unique_ptr<Fixture>> fixtures;
+    auto& f = fixtures[std::make_pair(num_vars, group_size)];
+    if (!f) f.reset(new Fixture(num_vars, group_size));
+    return *f;
+}
+
+void BM_fill_assumptions_backward(MicroBench::State& state)
+{
+    Fixture& f = get_fixture(state.range(0), state.range(1));
+    for (auto _ : state) {
+        f.comm.fill_assumptions_backward(f.assumptions, f.unknown, f.unknown_set, f.indep);
+    }
+    state.set_items_processed(state.iterations()*f.assumptions.size());
+}
+
+void BM_fill_assumptions_forward(MicroBench::State& state)
+{
+    Fixture& f = get_fixture(state.range(0), state.range(1));
+    for (auto _ : state) {
+        f.comm.fill_assumptions_forward(
+            f.assumptions, f.indep, f.unknown, f.unknown.size(), 0, f.guess_set);
+    }
+    state.set_items_processed(state.iterations()*f.assumptions.size());
+}
+
+void BM_fill_assumptions_guess(MicroBench::State& state)
+{
+    Fixture& f = get_fixture(state.range(0), state.range(1));
+    const uint32_t group = std::max<uint32_t>(f.unknown.size()/10, 1);
+    for (auto _ : state) {
+        f.comm.fill_assumptions_guess(
+            f.assumptions, f.indep, f.unknown, f.unknown_set,
+            group, 0, 9, f.dontremove_vars);
+    }
+    state.set_items_processed(state.iterations()*f.assumptions.size());
+}
+
+//{number of variables, group size}, group size 0 is no groups
+#define FILL_ARGS \
+    ->args({1000, 0})->args({1000, 2})->args({1000, 10}) \
+    ->args({10*1000, 0})->args({10*1000, 2})->args({10*1000, 10}) \
+    ->args({100*1000, 0})->args({100*1000, 2})->args({100*1000, 10})
+
+MICROBENCH(BM_fill_assumptions_backward) FILL_ARGS;
+MICROBENCH(BM_fill_assumptions_forward) FILL_ARGS;
+MICROBENCH(BM_fill_assumptions_guess) FILL_ARGS;
+
+}
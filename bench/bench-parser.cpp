@@ -0,0 +1,220 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+// Throughput of the grouped DIMACS parser on plain, gzipped and in-memory
+// input. The clauses go to a sink that only stores them, so the numbers are
+// for the parser alone. Kept out of the TU of the Common benchmarks, as
+// common.h brings in the streambuffer.h of CryptoMiniSat.
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "microbench.h"
+#include "dimacsparser-gis.h"
+#include "graphgen.h"
+
+using std::string;
+using std::vector;
+
+namespace {
+
+struct ClauseSink
+{
+    uint32_t num_vars = 0;
+    uint64_t num_lits = 0;
+    uint64_t num_cls = 0;
+
+    uint32_t nVars() const { return num_vars; }
+    void new_vars(uint32_t n) { num_vars += n; }
+    void new_var() { num_vars++; }
+    bool add_clause(const vector<CMSat::Lit>& lits)
+    {
+        num_lits += lits.size();
+        num_cls++;
+        return true;
+    }
+    bool add_xor_clause(const vector<uint32_t>& vars, bool)
+    {
+        num_lits += vars.size();
+        num_cls++;
+        return true;
+    }
+};
+
+// Random 3-CNF at the satisfiability threshold, with all variables in the
+// sampling set and in groups of 2, as the identifying code encodings are
+string make_cnf(uint32_t num_vars)
+{
+    GraphGen::Rand rnd(num_vars);
+    const uint64_t num_cls = (uint64_t)num_vars*42/10;
+    string out;
+    out.reserve(num_cls*24 + num_vars*16);
+    out += "p cnf " + std::to_string(num_vars) + " " + std::to_string(num_cls) + "\n";
+    out += "c ind";
+    for(uint32_t v = 1; v <= num_vars; v++) out += " " + std::to_string(v);
+    out += " 0\n";
+    for(uint32_t v = 1; v+1 <= num_vars; v += 2) {
+        out += "c grp " + std::to_string(v) + " " + std::to_string(v+1) + " 0\n";
+    }
+    for(uint64_t i = 0; i < num_cls; i++) {
+        for(uint32_t j = 0; j < 3; j++) {
+            if (rnd.below(2)) out += "-";
+            out += std::to_string(rnd.below(num_vars)+1) + " ";
+        }
+        out += "0\n";
+    }
+    return out;
+}
+
+const string& get_cnf(uint32_t num_vars)
+{
+    static std::map<uint32_t, string> cache;
+    auto it = cache.find(num_vars);
+    if (it == cache.end()) {
+        it = cache.insert(std::make_pair(num_vars, make_cnf(num_vars))).first;
+    }
+    return it->second;
+}
+
+// The generated files are removed when the benchmarks are done
+struct TmpFiles
+{
+    ~TmpFiles() { for(const auto& f: files) std::remove(f.c_str()); }
+    vector<string> files;
+};
+TmpFiles tmp_files;
+
+string tmp_name(uint32_t num_vars, const char* ext)
+{
+    const char* dir = std::getenv("TMPDIR");
+    return string(dir ? dir : "/tmp") + "/gismo-bench-"
+        + std::to_string(num_vars) + ext;
+}
+
+string get_plain_file(uint32_t num_vars)
+{
+    static std::map<uint32_t, string> written;
+    if (written.count(num_vars)) return written[num_vars];
+
+    const string& cnf = get_cnf(num_vars);
+    const string fname = tmp_name(num_vars, ".cnf");
+    FILE* f = fopen(fname.c_str(), "wb");
+    if (!f || fwrite(cnf.data(), 1, cnf.size(), f) != cnf.size()) {
+        std::cerr << "ERROR! Could not write '" << fname << "'" << endl;
+        std::exit(-1);
+    }
+    fclose(f);
+    tmp_files.files.push_back(fname);
+    written[num_vars] = fname;
+    return fname;
+}
+
+template<class P>
+void check_parsed(bool ok, const P& parser, const ClauseSink& sink, uint32_t num_vars)
+{
+    if (!ok || sink.num_vars != num_vars || parser.sampling_vars.size() != num_vars) {
+        std::cerr << "ERROR! Benchmark input was not parsed correctly" << endl;
+        std::exit(-1);
+    }
+}
+
+void BM_parse_plain(MicroBench::State& state)
+{
+    const uint32_t num_vars = state.range(0);
+    const string fname = get_plain_file(num_vars);
+    const uint64_t size = get_cnf(num_vars).size();
+    for (auto _ : state) {
+        ClauseSink sink;
+        DimacsParserGIS::DimacsParser<CMSat::StreamBuffer<FILE*, CMSat::FN>, ClauseSink>
+            parser(&sink, NULL, 0);
+        FILE* in = fopen(fname.c_str(), "rb");
+        const bool ok = parser.parse_DIMACS(in, false);
+        fclose(in);
+        check_parsed(ok, parser, sink, num_vars);
+    }
+    state.set_bytes_processed(state.iterations()*size);
+}
+MICROBENCH(BM_parse_plain)->arg(10*1000)->arg(100*1000)->arg(1000*1000);
+
+#ifdef USE_ZLIB
+string get_gz_file(uint32_t num_vars)
+{
+    static std::map<uint32_t, string> written;
+    if (written.count(num_vars)) return written[num_vars];
+
+    const string& cnf = get_cnf(num_vars);
+    const string fname = tmp_name(num_vars, ".cnf.gz");
+    gzFile f = gzopen(fname.c_str(), "wb");
+    if (!f || gzwrite(f, cnf.data(), cnf.size()) != (int)cnf.size()) {
+        std::cerr << "ERROR! Could not write '" << fname << "'" << endl;
+        std::exit(-1);
+    }
+    gzclose(f);
+    tmp_files.files.push_back(fname);
+    written[num_vars] = fname;
+    return fname;
+}
+
+//MB/s are counted on the uncompressed size
+void BM_parse_gz(MicroBench::State& state)
+{
+    const uint32_t num_vars = state.range(0);
+    const string fname = get_gz_file(num_vars);
+    const uint64_t size = get_cnf(num_vars).size();
+    for (auto _ : state) {
+        ClauseSink sink;
+        DimacsParserGIS::DimacsParser<CMSat::StreamBuffer<gzFile, CMSat::GZ>, ClauseSink>
+            parser(&sink, NULL, 0);
+        gzFile in = gzopen(fname.c_str(), "rb");
+        const bool ok = parser.parse_DIMACS(in, false);
+        gzclose(in);
+        check_parsed(ok, parser, sink, num_vars);
+    }
+    state.set_bytes_processed(state.iterations()*size);
+}
+MICROBENCH(BM_parse_gz)->arg(10*1000)->arg(100*1000)->arg(1000*1000);
+#endif
+
+void BM_parse_memory(MicroBench::State& state)
+{
+    const uint32_t num_vars = state.range(0);
+    const string& cnf = get_cnf(num_vars);
+    for (auto _ : state) {
+        ClauseSink sink;
+        DimacsParserGIS::DimacsParser<CMSat::StreamBuffer<CMSat::MemSpan, CMSat::MS>, ClauseSink>
+            parser(&sink, NULL, 0);
+        CMSat::MemSpan span{cnf.data(), cnf.data() + cnf.size()};
+        const bool ok = parser.parse_DIMACS(span, false);
+        check_parsed(ok, parser, sink, num_vars);
+    }
+    state.set_bytes_processed(state.iterations()*cnf.size());
+}
+MICROBENCH(BM_parse_memory)->arg(10*1000)->arg(100*1000)->arg(1000*1000);
+
+}
@@ -0,0 +1,183 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef GISMO_GRAPHGEN_H
+#define GISMO_GRAPHGEN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <cmath>
+
+namespace GraphGen {
+
+typedef std::vector<std::pair<uint32_t, uint32_t>> Edges;
+
+/** splitmix64. The standard library distributions are not the same across
+ * implementations, so generate everything from raw 64-bit values to get the
+ * same graphs everywhere for the same seed. */
+class Rand
+{
+public:
+    explicit Rand(uint64_t seed) : state(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    //Uniform in [0, n)
+    uint32_t below(uint32_t n)
+    {
+        return (uint32_t)(next() % n);
+    }
+
+    //Uniform in [0, 1)
+    double unit()
+    {
+        return (double)(next() >> 11) * (1.0/9007199254740992.0);
+    }
+
+private:
+    uint64_t state;
+};
+
+inline std::pair<uint32_t, uint32_t> norm_edge(uint32_t u, uint32_t v)
+{
+    return u < v ? std::make_pair(u, v) : std::make_pair(v, u);
+}
+
+/** Erdos-Renyi G(n, m) with m = n*avg_deg/2 distinct edges, no self-loops */
+inline Edges erdos_renyi(uint32_t n, double avg_deg, Rand& rnd)
+{
+    const uint64_t max_m = (uint64_t)n*(n-1)/2;
+    const uint64_t m = std::min<uint64_t>((uint64_t)(n*avg_deg/2.0), max_m);
+    std::set<std::pair<uint32_t, uint32_t>> seen;
+    Edges edges;
+    while(edges.size() < m) {
+        uint32_t u = rnd.below(n);
+        uint32_t v = rnd.below(n);
+        if (u == v) continue;
+        auto e = norm_edge(u, v);
+        if (seen.insert(e).second) edges.push_back(e);
+    }
+    return edges;
+}
+
+/** Barabasi-Albert preferential attachment: every new node connects to
+ * avg_deg/2 distinct existing nodes, chosen proportionally to their degree */
+inline Edges barabasi_albert(uint32_t n, double avg_deg, Rand& rnd)
+{
+    const uint32_t m = std::max<uint32_t>(1, (uint32_t)(avg_deg/2.0 + 0.5));
+    Edges edges;
+    //Every edge puts both endpoints here, so picking a uniform element picks
+    //a node proportionally to its degree
+    std::vector<uint32_t> endpoints;
+
+    //Start from a clique on m+1 nodes
+    const uint32_t start = std::min(n, m+1);
+    for(uint32_t u = 0; u < start; u++) {
+        for(uint32_t v = u+1; v < start; v++) {
+            edges.push_back(norm_edge(u, v));
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+
+    std::vector<uint32_t> targets;
+    for(uint32_t u = start; u < n; u++) {
+        targets.clear();
+        while(targets.size() < std::min(m, u)) {
+            uint32_t v = endpoints[rnd.below(endpoints.size())];
+            if (std::find(targets.begin(), targets.end(), v) == targets.end()) {
+                targets.push_back(v);
+            }
+        }
+        for(uint32_t v: targets) {
+            edges.push_back(norm_edge(u, v));
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    return edges;
+}
+
+/** Square 4-neighbour grid with side ceil(sqrt(n)) */
+inline Edges grid(uint32_t n)
+{
+    const uint32_t side = std::max<uint32_t>(2, (uint32_t)std::ceil(std::sqrt((double)n)));
+    Edges edges;
+    for(uint32_t r = 0; r < side; r++) {
+        for(uint32_t c = 0; c < side; c++) {
+            const uint32_t at = r*side + c;
+            if (c+1 < side) edges.push_back(norm_edge(at, at+1));
+            if (r+1 < side) edges.push_back(norm_edge(at, at+side));
+        }
+    }
+    return edges;
+}
+
+/** Road-network-like graph: a grid where a fifth of the streets are missing
+ * and a few percent of the blocks have a diagonal shortcut. Degrees stay
+ * between 1 and 5 and the graph is near-planar, as for road networks. */
+inline Edges road_like(uint32_t n, Rand& rnd)
+{
+    const uint32_t side = std::max<uint32_t>(2, (uint32_t)std::ceil(std::sqrt((double)n)));
+    Edges edges;
+    for(uint32_t r = 0; r < side; r++) {
+        for(uint32_t c = 0; c < side; c++) {
+            const uint32_t at = r*side + c;
+            if (c+1 < side && rnd.unit() >= 0.2) edges.push_back(norm_edge(at, at+1));
+            if (r+1 < side && rnd.unit() >= 0.2) edges.push_back(norm_edge(at, at+side));
+            if (c+1 < side && r+1 < side && rnd.unit() < 0.05) {
+                edges.push_back(norm_edge(at, at+side+1));
+            }
+        }
+    }
+    return edges;
+}
+
+inline bool known_family(const std::string& family)
+{
+    return family == "er" || family == "ba" || family == "grid" || family == "road";
+}
+
+inline Edges generate(const std::string& family, uint32_t n, double avg_deg, Rand& rnd)
+{
+    if (family == "er") return erdos_renyi(n, avg_deg, rnd);
+    if (family == "ba") return barabasi_albert(n, avg_deg, rnd);
+    if (family == "grid") return grid(n);
+    return road_like(n, rnd);
+}
+
+}
+
+#endif //GISMO_GRAPHGEN_H
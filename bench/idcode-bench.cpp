@@ -0,0 +1,381 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+// Scaling benchmark for the identifying code pipeline. Generates graphs from
+// a few random families at growing sizes, builds the grouped encoding for
+// every k asked for, runs the library on them, and reports time, size of
+// the independent support and memory. The same seed gives the same graphs
+// on every platform, so numbers from different builds can be compared.
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "time_mem.h"
+#include "arjun.h"
+#include "edgesparser-gis.h"
+#include "graphgen.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+struct BenchResult
+{
+    string family;
+    uint32_t size = 0;
+    uint32_t k = 0;
+    uint32_t nodes = 0;
+    uint64_t edges = 0;
+    uint32_t vars = 0;
+    uint32_t indep_vars = 0;
+    uint32_t indep_groups = 0;
+    double wall_time = 0;
+    double cpu_time = 0;
+    uint64_t conflicts = 0;
+    uint64_t mem_peak = 0;
+};
+
+template<class T>
+static vector<T> split_list(const string& str)
+{
+    vector<T> ret;
+    std::stringstream ss(str);
+    string item;
+    while(std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        std::stringstream conv(item);
+        T val;
+        conv >> val;
+        if (conv.fail()) {
+            cerr << "ERROR! Could not parse list element '" << item << "'" << endl;
+            std::exit(-1);
+        }
+        ret.push_back(val);
+    }
+    return ret;
+}
+
+static BenchResult run_one(
+    const string& family,
+    uint32_t size,
+    uint32_t k,
+    const GraphGen::Edges& graph,
+    bool use_bnn,
+    uint32_t maxc,
+    int verb)
+{
+    BenchResult res;
+    res.family = family;
+    res.size = size;
+    res.k = k;
+
+    ArjunNS::Arjun arjun;
+    arjun.set_verbosity(verb);
+    arjun.set_backw_max_confl(maxc);
+
+    EdgesParserGIS::EdgesParser<CMSat::StreamBuffer<FILE*, CMSat::FN>, ArjunNS::Arjun>
+        parser(&arjun, verb);
+    for(const auto& e: graph) parser.add_edge(e.first, e.second);
+    parser.build(k, use_bnn);
+
+    arjun.set_starting_sampling_set(parser.sampling_vars);
+    arjun.set_group_independent_support(true);
+    arjun.set_variable_groups(parser.var2var_group, parser.var_groups);
+    res.nodes = parser.num_nodes;
+    res.edges = parser.num_edges;
+    res.vars = arjun.nVars();
+
+    const double start_wall = wallTime();
+    const double start_cpu = cpuTime();
+    const vector<uint32_t> indep = arjun.get_indep_set();
+    res.wall_time = wallTime() - start_wall;
+    res.cpu_time = cpuTime() - start_cpu;
+
+    std::set<uint32_t> groups;
+    for(uint32_t v: indep) groups.insert(arjun.get_var_group(v));
+    res.indep_vars = indep.size();
+    res.indep_groups = groups.size();
+
+    const ArjunNS::RunStats stats = arjun.get_run_stats();
+    res.conflicts = stats.conflicts;
+    res.mem_peak = stats.mem_peak;
+    return res;
+}
+
+#ifndef _WIN32
+// The peak RSS is that of the whole process, so every case runs in a child
+// of its own, otherwise the column would show the largest case so far
+static bool run_one_forked(
+    const string& family,
+    uint32_t size,
+    uint32_t k,
+    const GraphGen::Edges& graph,
+    bool use_bnn,
+    uint32_t maxc,
+    int verb,
+    BenchResult& res)
+{
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    cout << std::flush;
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        const BenchResult r = run_one(family, size, k, graph, use_bnn, maxc, verb);
+        std::stringstream ss;
+        ss << std::setprecision(6) << std::fixed
+        << r.nodes << " " << r.edges << " " << r.vars << " "
+        << r.indep_vars << " " << r.indep_groups << " "
+        << r.wall_time << " " << r.cpu_time << " "
+        << r.conflicts << " " << r.mem_peak << "\n";
+        const string out = ss.str();
+        size_t at = 0;
+        while(at < out.size()) {
+            const ssize_t w = write(fds[1], out.data()+at, out.size()-at);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) break;
+            at += w;
+        }
+        cout << std::flush;
+        _exit(0);
+    }
+
+    close(fds[1]);
+    string out;
+    for(;;) {
+        char buf[512];
+        const ssize_t r = read(fds[0], buf, sizeof(buf));
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) break;
+        out.append(buf, r);
+    }
+    close(fds[0]);
+    int wstatus;
+    while(waitpid(pid, &wstatus, 0) < 0 && errno == EINTR) {}
+
+    res = BenchResult();
+    res.family = family;
+    res.size = size;
+    res.k = k;
+    std::stringstream ss(out);
+    ss >> res.nodes >> res.edges >> res.vars
+    >> res.indep_vars >> res.indep_groups
+    >> res.wall_time >> res.cpu_time
+    >> res.conflicts >> res.mem_peak;
+    return !ss.fail();
+}
+#endif
+
+static void print_header()
+{
+    cout
+    << std::setw(6) << "family"
+    << std::setw(8) << "size"
+    << std::setw(4) << "k"
+    << std::setw(8) << "nodes"
+    << std::setw(9) << "edges"
+    << std::setw(9) << "vars"
+    << std::setw(8) << "GIS"
+    << std::setw(8) << "GIS-v"
+    << std::setw(10) << "wall(s)"
+    << std::setw(10) << "cpu(s)"
+    << std::setw(11) << "confl"
+    << std::setw(10) << "mem(MB)"
+    << endl;
+}
+
+static void print_result(const BenchResult& r)
+{
+    cout
+    << std::setw(6) << r.family
+    << std::setw(8) << r.size
+    << std::setw(4) << r.k
+    << std::setw(8) << r.nodes
+    << std::setw(9) << r.edges
+    << std::setw(9) << r.vars
+    << std::setw(8) << r.indep_groups
+    << std::setw(8) << r.indep_vars
+    << std::setw(10) << std::setprecision(3) << std::fixed << r.wall_time
+    << std::setw(10) << r.cpu_time
+    << std::setw(11) << r.conflicts
+    << std::setw(10) << std::setprecision(1) << (double)r.mem_peak/(1024.0*1024.0)
+    << endl;
+}
+
+static void write_csv_line(std::ofstream& out, const BenchResult& r)
+{
+    out
+    << r.family << ","
+    << r.size << ","
+    << r.k << ","
+    << r.nodes << ","
+    << r.edges << ","
+    << r.vars << ","
+    << r.indep_groups << ","
+    << r.indep_vars << ","
+    << std::setprecision(6) << std::fixed << r.wall_time << ","
+    << r.cpu_time << ","
+    << r.conflicts << ","
+    << r.mem_peak
+    << endl;
+}
+
+int main(int argc, char** argv)
+{
+    string families_str = "er,ba,grid,road";
+    string sizes_str = "50,100,200,400,800";
+    string ks_str = "1,2";
+    string csvfile;
+    double avg_deg = 4.0;
+    uint64_t seed = 1;
+    uint32_t repeat = 1;
+    int use_bnn = 1;
+    uint32_t maxc = 500;
+    int verb = 0;
+
+    po::options_description opts("Identifying code benchmark options");
+    opts.add_options()
+    ("help,h", "Prints help")
+    ("families", po::value(&families_str)->default_value(families_str),
+     "Comma-separated graph families: er (Erdos-Renyi), ba (Barabasi-Albert), grid, road")
+    ("sizes", po::value(&sizes_str)->default_value(sizes_str),
+     "Comma-separated number of nodes to generate")
+    ("k", po::value(&ks_str)->default_value(ks_str),
+     "Comma-separated values of k, at most this many nodes are TRUE")
+    ("deg", po::value(&avg_deg)->default_value(avg_deg),
+     "Average degree of the er and ba graphs")
+    ("seed", po::value(&seed)->default_value(seed),
+     "Seed of the graph generators")
+    ("repeat", po::value(&repeat)->default_value(repeat),
+     "Number of different graphs per family and size")
+    ("bnn", po::value(&use_bnn)->default_value(use_bnn),
+     "Encode the cardinality constraint as a BNN constraint instead of a CNF")
+    ("maxc", po::value(&maxc)->default_value(maxc),
+     "Maximum conflicts per variable in backward mode")
+    ("verb,v", po::value(&verb)->default_value(verb),
+     "Verbosity of the library")
+    ("csv", po::value(&csvfile),
+     "Also write the results to this file as CSV")
+    ;
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, opts), vm);
+        if (vm.count("help")) {
+            cout << "gismo-idcode-bench [options]" << endl << endl;
+            cout << opts << endl;
+            return 0;
+        }
+        po::notify(vm);
+    } catch (po::error& e) {
+        cerr
+        << "ERROR: " << e.what() << endl
+        << "       Please give '--help' to get help" << endl;
+        std::exit(-1);
+    }
+
+    const vector<string> families = split_list<string>(families_str);
+    const vector<uint32_t> sizes = split_list<uint32_t>(sizes_str);
+    const vector<uint32_t> ks = split_list<uint32_t>(ks_str);
+    for(const auto& f: families) {
+        if (!GraphGen::known_family(f)) {
+            cerr << "ERROR! Unknown graph family '" << f << "'" << endl;
+            std::exit(-1);
+        }
+    }
+    for(const auto s: sizes) {
+        if (s < 2) {
+            cerr << "ERROR! Graphs must have at least 2 nodes" << endl;
+            std::exit(-1);
+        }
+    }
+
+    std::ofstream csv;
+    if (!csvfile.empty()) {
+        csv.open(csvfile.c_str(), std::ios::out);
+        if (!csv) {
+            cerr
+            << "ERROR! Could not open file '"
+            << csvfile
+            << "' for writing" << endl;
+            std::exit(-1);
+        }
+        csv << "family,size,k,nodes,edges,vars,indep_groups,indep_vars,"
+        << "wall_time,cpu_time,conflicts,mem_peak_bytes" << endl;
+    }
+
+    print_header();
+    for(const auto& family: families) {
+        for(const auto size: sizes) {
+            for(uint32_t rep = 0; rep < repeat; rep++) {
+                //Same graph for all k, and the same graph for a given
+                //family, size and repetition whatever else is on the list
+                GraphGen::Rand rnd(seed*1000003ULL + size*31ULL + rep);
+                const GraphGen::Edges graph =
+                    GraphGen::generate(family, size, avg_deg, rnd);
+                for(const auto k: ks) {
+                    #ifndef _WIN32
+                    BenchResult res;
+                    if (!run_one_forked(family, size, k, graph, use_bnn, maxc, verb, res)) {
+                        cerr << "ERROR! The run of " << family << " size " << size
+                        << " k " << k << " failed" << endl;
+                        continue;
+                    }
+                    #else
+                    const BenchResult res =
+                        run_one(family, size, k, graph, use_bnn, maxc, verb);
+                    #endif
+                    print_result(res);
+                    if (csv.is_open()) write_csv_line(csv, res);
+                }
+            }
+        }
+    }
+    return 0;
+}
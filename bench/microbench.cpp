@@ -0,0 +1,160 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "microbench.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace MicroBench {
+
+static vector<Benchmark*>& registry()
+{
+    static vector<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+Benchmark* register_benchmark(const string& name, std::function<void(State&)> fn)
+{
+    Benchmark* b = new Benchmark(name, fn);
+    registry().push_back(b);
+    return b;
+}
+
+static string pretty_time(double secs)
+{
+    std::stringstream ss;
+    ss << std::setprecision(1) << std::fixed;
+    if (secs < 1e-6) ss << secs*1e9 << " ns";
+    else if (secs < 1e-3) ss << secs*1e6 << " us";
+    else if (secs < 1) ss << secs*1e3 << " ms";
+    else ss << secs << " s";
+    return ss.str();
+}
+
+static string pretty_rate(double per_sec, const char* unit)
+{
+    std::stringstream ss;
+    ss << std::setprecision(1) << std::fixed;
+    if (per_sec >= 1e9) ss << per_sec/1e9 << " G" << unit << "/s";
+    else if (per_sec >= 1e6) ss << per_sec/1e6 << " M" << unit << "/s";
+    else if (per_sec >= 1e3) ss << per_sec/1e3 << " k" << unit << "/s";
+    else ss << per_sec << " " << unit << "/s";
+    return ss.str();
+}
+
+// Grows the number of iterations until one run takes at least min_time,
+// the way Google Benchmark does, and reports that last run
+static void run_one(const Benchmark& b, const vector<int64_t>& args, double min_time)
+{
+    string name = b.name;
+    for(const auto a: args) name += "/" + std::to_string(a);
+
+    uint64_t iters = 1;
+    for(;;) {
+        State state(iters, args);
+        b.fn(state);
+        const double secs = state.seconds();
+        const bool last = secs >= min_time || iters >= 1000ULL*1000ULL*1000ULL;
+        if (!last) {
+            //Aim a bit above the minimum, but grow at most 10x at a time
+            double mult = secs <= 0 ? 10.0 : (min_time*1.4)/secs;
+            if (mult > 10.0) mult = 10.0;
+            if (mult < 2.0) mult = 2.0;
+            iters = (uint64_t)((double)iters*mult);
+            continue;
+        }
+
+        cout
+        << std::setw(48) << std::left << name << std::right
+        << std::setw(14) << pretty_time(secs/(double)iters)
+        << std::setw(12) << iters;
+        if (state.bytes) {
+            cout << std::setw(16) << pretty_rate((double)state.bytes/secs, "B");
+        }
+        if (state.items) {
+            cout << std::setw(18) << pretty_rate((double)state.items/secs, "items");
+        }
+        if (!state.label.empty()) cout << "  " << state.label;
+        cout << endl;
+        break;
+    }
+}
+
+int run_benchmarks(int argc, char** argv)
+{
+    string filter;
+    double min_time = 0.5;
+    for(int i = 1; i < argc; i++) {
+        const string arg(argv[i]);
+        if (arg.compare(0, 19, "--benchmark_filter=") == 0) {
+            filter = arg.substr(19);
+        } else if (arg.compare(0, 21, "--benchmark_min_time=") == 0) {
+            min_time = std::atof(arg.c_str()+21);
+        } else if (arg == "--benchmark_list_tests") {
+            for(const auto b: registry()) cout << b->name << endl;
+            return 0;
+        } else {
+            cerr
+            << "ERROR: Unknown option '" << arg << "'" << endl
+            << "       Options: --benchmark_filter=SUBSTRING"
+            << " --benchmark_min_time=SECONDS --benchmark_list_tests" << endl;
+            return -1;
+        }
+    }
+
+    cout
+    << std::setw(48) << std::left << "Benchmark" << std::right
+    << std::setw(14) << "Time"
+    << std::setw(12) << "Iterations"
+    << endl
+    << string(74, '-') << endl;
+    for(const auto b: registry()) {
+        if (!filter.empty() && b->name.find(filter) == string::npos) continue;
+        if (b->arg_sets.empty()) {
+            run_one(*b, vector<int64_t>(), min_time);
+        } else {
+            for(const auto& args: b->arg_sets) run_one(*b, args, min_time);
+        }
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    return MicroBench::run_benchmarks(argc, argv);
+}
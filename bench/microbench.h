@@ -0,0 +1,144 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef GISMO_MICROBENCH_H
+#define GISMO_MICROBENCH_H
+
+// A small harness in the style of Google Benchmark, so that gismo-bench does
+// not pull in another dependency. Benchmarks are functions taking a State,
+// timed over as many iterations as needed to fill the minimum time:
+//
+//   static void BM_foo(MicroBench::State& state) {
+//       setup(state.range(0));
+//       for (auto _ : state) foo();
+//       state.set_bytes_processed(state.iterations()*bytes_per_foo);
+//   }
+//   MICROBENCH(BM_foo)->arg(1000)->arg(10000);
+
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace MicroBench {
+
+class State
+{
+public:
+    State(uint64_t _max_iters, const std::vector<int64_t>& _args) :
+        max_iters(_max_iters),
+        args(_args)
+    {}
+
+    //Has a destructor so that the unused loop variable is not warned about
+    struct Value { ~Value() {} };
+
+    struct Iterator
+    {
+        State* state;
+        uint64_t left;
+        bool operator!=(const Iterator&)
+        {
+            if (left == 0) {
+                state->finish();
+                return false;
+            }
+            return true;
+        }
+        void operator++() { left--; }
+        Value operator*() const { return Value(); }
+    };
+
+    Iterator begin()
+    {
+        resume_timing();
+        return Iterator{this, max_iters};
+    }
+    Iterator end() { return Iterator{this, 0}; }
+
+    //Leave setup that must happen every iteration out of the measurement
+    void pause_timing()
+    {
+        elapsed += std::chrono::steady_clock::now() - started;
+    }
+    void resume_timing()
+    {
+        started = std::chrono::steady_clock::now();
+    }
+
+    int64_t range(size_t i = 0) const { return args.at(i); }
+    uint64_t iterations() const { return max_iters; }
+    void set_bytes_processed(uint64_t b) { bytes = b; }
+    void set_items_processed(uint64_t i) { items = i; }
+    void set_label(const std::string& l) { label = l; }
+
+    double seconds() const
+    {
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+    uint64_t bytes = 0;
+    uint64_t items = 0;
+    std::string label;
+
+private:
+    void finish() { pause_timing(); }
+
+    uint64_t max_iters;
+    std::vector<int64_t> args;
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::duration::zero();
+    std::chrono::steady_clock::time_point started;
+};
+
+class Benchmark
+{
+public:
+    Benchmark(const std::string& _name, std::function<void(State&)> _fn) :
+        name(_name),
+        fn(_fn)
+    {}
+
+    Benchmark* arg(int64_t a) { arg_sets.push_back({a}); return this; }
+    Benchmark* args(const std::vector<int64_t>& a) { arg_sets.push_back(a); return this; }
+
+    std::string name;
+    std::function<void(State&)> fn;
+    std::vector<std::vector<int64_t>> arg_sets;
+};
+
+Benchmark* register_benchmark(const std::string& name, std::function<void(State&)> fn);
+int run_benchmarks(int argc, char** argv);
+
+}
+
+#define MICROBENCH_CONCAT2(a, b) a##b
+#define MICROBENCH_CONCAT(a, b) MICROBENCH_CONCAT2(a, b)
+#define MICROBENCH(fn) \
+    static MicroBench::Benchmark* MICROBENCH_CONCAT(microbench_, __LINE__) = \
+        MicroBench::register_benchmark(#fn, fn)
+
+#endif //GISMO_MICROBENCH_H
@@ -69,27 +69,54 @@ DLL_PUBLIC Arjun::~Arjun()
 // }
 
 
+DLL_PUBLIC void Arjun::reset()
+{
+    arjdata->common.reset();
+}
+
 DLL_PUBLIC uint32_t Arjun::nVars() {
     return arjdata->common.solver->nVars();
 }
 
+// Once the formula is duplicated, these would only reach its first copy
 DLL_PUBLIC void Arjun::new_vars(uint32_t num)
 {
+    assert(!arjdata->common.duplicated);
+    if (arjdata->common.duplicated) return;
     arjdata->common.solver->new_vars(num);
 }
 
 DLL_PUBLIC void Arjun::new_var()
 {
+    assert(!arjdata->common.duplicated);
+    if (arjdata->common.duplicated) return;
     arjdata->common.solver->new_var();
 }
 
 DLL_PUBLIC bool Arjun::add_clause(const vector<CMSat::Lit>& lits)
 {
+    if (arjdata->common.duplicated) return arjdata->common.add_clause_for_good(lits);
     return arjdata->common.solver->add_clause(lits);
 }
 
+DLL_PUBLIC uint32_t Arjun::add_removable_clause(const vector<CMSat::Lit>& lits, bool active)
+{
+    return arjdata->common.add_removable_clause(lits, active);
+}
+
+DLL_PUBLIC bool Arjun::set_clause_active(uint32_t id, bool active)
+{
+    return arjdata->common.set_clause_active(id, active);
+}
+
+DLL_PUBLIC bool Arjun::remove_clause(uint32_t id)
+{
+    return arjdata->common.remove_clause(id);
+}
+
 DLL_PUBLIC bool Arjun::add_xor_clause(const vector<uint32_t>& vars, bool rhs)
 {
+    if (arjdata->common.duplicated) return false;
     return arjdata->common.solver->add_xor_clause(vars, rhs);
 }
 
@@ -99,6 +126,7 @@ DLL_PUBLIC bool Arjun::add_bnn_clause(
             Lit out
         )
 {
+    if (arjdata->common.duplicated) return false;
     return arjdata->common.solver->add_bnn_clause(lits, cutoff, out);
 }
 
@@ -132,35 +160,73 @@ DLL_PUBLIC std::string Arjun::get_compilation_env()
 DLL_PUBLIC vector<uint32_t> Arjun::get_indep_set()
 {
     double starTime = cpuTime();
+    Common& c = arjdata->common;
+    if (c.conf.time_limit > 0 || c.conf.confl_budget_total > 0 || c.conf.mem_limit > 0) {
+        c.budget.start(c.conf.time_limit, c.conf.confl_budget_total, c.conf.mem_limit,
+            c.solver->get_sum_conflicts(), &c.interrupt_flag, &c.solver_interrupt);
+    }
+    if (c.duplicated) {
+        c.redo_after_edits();
+        goto end;
+    }
     if (!arjdata->common.preproc_and_duplicate()) goto end;
+    if (c.hint_superset && !c.hint.empty()) c.restrict_to_hint();
 
     // Guess
-    if (arjdata->common.conf.guess) arjdata->common.run_guess();
+    if (arjdata->common.conf.guess && arjdata->common.start_optional("guess")) {
+        arjdata->common.run_guess();
+        arjdata->common.end_optional();
+    }
 
     // Forward
-    if (arjdata->common.conf.forward) {
+    if (arjdata->common.conf.forward && arjdata->common.start_optional("forward")) {
         arjdata->common.forward_round(5000000, arjdata->common.conf.forward_group, 0);
+        arjdata->common.end_optional();
     }
 
     //Backward
-    if (arjdata->common.conf.backward) {
+    if (arjdata->common.conf.backward && !arjdata->common.interrupted()) {
         arjdata->common.backward_round();
     }
 
     end:
+    AsyncLog::get().flush();
+    c.budget.finish();
+    if (c.budget.stopped_by() && c.conf.verb) {
+        cout << "c [arjun-budget] out of " << c.budget.stopped_by()
+        << ", returning the set found so far" << endl;
+    }
+    c.budget.clear();
+    c.solver_interrupt.store(false);
+    arjdata->common.stats.interrupted = arjdata->common.interrupt_flag.exchange(false);
     arjdata->common.empty_out_indep_set_if_unsat();
+    if (arjdata->common.qlog && !arjdata->common.qlog->sync()) {
+        cout << "c [arjun] WARNING: could not write all of the query log" << endl;
+    }
     if (arjdata->common.conf.verb) {
+        arjdata->common.print_phase_stats();
+        arjdata->common.print_oracle_stats();
         cout << "c [arjun] get_indep_set finished "
         << "T: " << std::setprecision(2) << std::fixed << (cpuTime() - starTime)
         << endl;
     }
 
+    c.prev_indep_set = *c.sampling_set;
+
     // Deal with empty_occs
     arjdata->common.sampling_set->insert(
         arjdata->common.sampling_set->begin(),
         arjdata->common.empty_occs.begin(),
         arjdata->common.empty_occs.end());
 
+    // Whatever was not streamed by backward (e.g. empty occs) goes out now
+    if (arjdata->common.indep_cb) {
+        for(const auto& v: *arjdata->common.sampling_set) {
+            arjdata->common.report_indep(v);
+        }
+        arjdata->common.report_indep_done(*arjdata->common.sampling_set);
+    }
+
     return *arjdata->common.sampling_set;
 }
 
@@ -201,6 +267,7 @@ DLL_PUBLIC void Arjun::set_verbosity(uint32_t verb)
 
 DLL_PUBLIC void Arjun::set_seed(uint32_t seed)
 {
+    arjdata->common.conf.seed = seed;
     arjdata->common.random_source.seed(seed);
 }
 
@@ -276,6 +343,46 @@ DLL_PUBLIC void Arjun::set_backw_max_confl(uint32_t backw_max_confl)
     arjdata->common.conf.backw_max_confl = backw_max_confl;
 }
 
+DLL_PUBLIC void Arjun::set_trace_solve_every(uint32_t trace_solve_every)
+{
+    arjdata->common.conf.trace_solve_every = std::max<uint32_t>(trace_solve_every, 1);
+}
+
+DLL_PUBLIC void Arjun::set_perf_counters(bool perf_counters)
+{
+    arjdata->common.conf.perf_counters = perf_counters;
+}
+
+DLL_PUBLIC void Arjun::set_heartbeat(double heartbeat)
+{
+    arjdata->common.conf.heartbeat = heartbeat;
+}
+
+DLL_PUBLIC void Arjun::set_time_limit(double seconds)
+{
+    arjdata->common.conf.time_limit = seconds;
+}
+
+DLL_PUBLIC void Arjun::set_conflict_budget_total(uint64_t conflicts)
+{
+    arjdata->common.conf.confl_budget_total = conflicts;
+}
+
+DLL_PUBLIC void Arjun::set_memory_limit(uint64_t bytes)
+{
+    arjdata->common.conf.mem_limit = bytes;
+}
+
+DLL_PUBLIC void Arjun::set_guess_max_confl(uint32_t guess_max_confl)
+{
+    arjdata->common.conf.guess_max_confl = guess_max_confl;
+}
+
+DLL_PUBLIC uint32_t Arjun::get_guess_max_confl() const
+{
+    return arjdata->common.conf.guess_max_confl;
+}
+
 DLL_PUBLIC void Arjun::set_backbone_simpl_max_confl(uint64_t backbone_simpl_max_confl)
 {
     arjdata->common.conf.backbone_simpl_max_confl = backbone_simpl_max_confl;
@@ -356,6 +463,36 @@ DLL_PUBLIC uint32_t Arjun::get_backw_max_confl() const
     return arjdata->common.conf.backw_max_confl;
 }
 
+DLL_PUBLIC uint32_t Arjun::get_trace_solve_every() const
+{
+    return arjdata->common.conf.trace_solve_every;
+}
+
+DLL_PUBLIC bool Arjun::get_perf_counters() const
+{
+    return arjdata->common.conf.perf_counters;
+}
+
+DLL_PUBLIC double Arjun::get_heartbeat() const
+{
+    return arjdata->common.conf.heartbeat;
+}
+
+DLL_PUBLIC double Arjun::get_time_limit() const
+{
+    return arjdata->common.conf.time_limit;
+}
+
+DLL_PUBLIC uint64_t Arjun::get_conflict_budget_total() const
+{
+    return arjdata->common.conf.confl_budget_total;
+}
+
+DLL_PUBLIC uint64_t Arjun::get_memory_limit() const
+{
+    return arjdata->common.conf.mem_limit;
+}
+
 DLL_PUBLIC void Arjun::set_gauss_jordan(bool gauss_jordan)
 {
     arjdata->common.conf.gauss_jordan = gauss_jordan;
@@ -456,6 +593,80 @@ DLL_PUBLIC vector<uint32_t> Arjun::get_empty_occ_sampl_vars() const
     return arjdata->common.empty_occs;
 }
 
+DLL_PUBLIC InstanceFeatures Arjun::get_instance_features()
+{
+    InstanceFeatures f;
+    arjdata->common.compute_features(f);
+    return f;
+}
+
+DLL_PUBLIC void Arjun::interrupt_asap()
+{
+    arjdata->common.interrupt_flag.store(true);
+    arjdata->common.solver_interrupt.store(true);
+}
+
+DLL_PUBLIC void Arjun::set_indep_callback(IndepCallback cb)
+{
+    arjdata->common.indep_cb = cb;
+}
+
+DLL_PUBLIC void Arjun::set_progress_callback(ProgressCallback cb)
+{
+    arjdata->common.progress_cb = cb;
+}
+
+DLL_PUBLIC void Arjun::set_hint_indep_set(const vector<uint32_t>& vars, bool verified_superset)
+{
+    arjdata->common.hint = vars;
+    arjdata->common.hint_superset = verified_superset;
+}
+
+DLL_PUBLIC void Arjun::start_trace(size_t capacity)
+{
+    delete arjdata->common.tracer;
+    arjdata->common.tracer = new Tracer(capacity);
+}
+
+DLL_PUBLIC bool Arjun::write_trace(const std::string& fname) const
+{
+    if (!arjdata->common.tracer) return false;
+    return arjdata->common.tracer->write_json(fname);
+}
+
+DLL_PUBLIC bool Arjun::record_queries(const std::string& fname)
+{
+    if (arjdata->common.qlog && !arjdata->common.qlog->close()) {
+        cout << "c [arjun] WARNING: could not write all of the query log" << endl;
+    }
+    delete arjdata->common.qlog;
+    arjdata->common.qlog = NULL;
+    if (fname.empty()) return true;
+
+    arjdata->common.qlog = new QueryLogWriter;
+    if (!arjdata->common.qlog->open(fname, nVars())) {
+        delete arjdata->common.qlog;
+        arjdata->common.qlog = NULL;
+        return false;
+    }
+    return true;
+}
+
+DLL_PUBLIC bool Arjun::replay_queries(const std::string& fname, int64_t max_confl)
+{
+    return arjdata->common.replay_queries(fname, max_confl);
+}
+
+DLL_PUBLIC RunStats Arjun::get_run_stats() const
+{
+    RunStats stats = arjdata->common.stats;
+    stats.conflicts = arjdata->common.solver->get_sum_conflicts();
+    double vm_usage;
+    stats.mem_peak = std::max<uint64_t>(stats.mem_peak, memUsedTotal(vm_usage));
+    stats.mem_peak = std::max<uint64_t>(stats.mem_peak, memPeakTotal());
+    return stats;
+}
+
 DLL_PUBLIC const vector<Lit> Arjun::get_simplified_cnf() const
 {
     vector<Lit> cnf;
@@ -527,11 +738,13 @@ vector<Lit> fill_solver_no_empty(
     const vector<uint32_t>& empty_vars,
     const uint32_t orig_num_vars,
     SATSolver& solver,
-    Arjun* arjun)
+    Arjun* arjun,
+    vector<uint32_t>& back_map)
 {
     solver.new_vars(orig_num_vars-empty_vars.size());
     vector<char> seen(orig_num_vars, 0);
     vector<uint32_t> mymap;
+    back_map.clear();
     for(auto const& e: empty_vars) {
         assert(e < orig_num_vars);
         seen[e] = 1;
@@ -541,6 +754,7 @@ vector<Lit> fill_solver_no_empty(
     for(uint32_t i = 0; i < orig_num_vars; i++) {
         if (!seen[i]) {
             mymap.push_back(at);
+            back_map.push_back(i);
             at++;
         } else {
             mymap.push_back(numeric_limits<uint32_t>::max());
@@ -591,7 +805,7 @@ vector<Lit> fill_solver_no_empty(
     return dont_elim;
 }
 
-DLL_PUBLIC std::tuple<pair<vector<vector<Lit>>, uint32_t>, vector<uint32_t>, uint32_t>
+DLL_PUBLIC std::tuple<pair<vector<vector<Lit>>, uint32_t>, vector<uint32_t>, uint32_t, vector<vector<uint32_t>>>
 Arjun::get_fully_simplified_renumbered_cnf(
     const vector<uint32_t>& sampl_set,
     const vector<uint32_t>& empty_vars,
@@ -599,7 +813,8 @@ Arjun::get_fully_simplified_renumbered_cnf(
 {
     CMSat::SATSolver solver;
     solver.set_verbosity(2);
-    auto dont_elim = fill_solver_no_empty(sampl_set, empty_vars, orig_num_vars, solver, this);
+    vector<uint32_t> back_map;
+    auto dont_elim = fill_solver_no_empty(sampl_set, empty_vars, orig_num_vars, solver, this, back_map);
 
     //Below works VERY WELL for: ProcessBean, pollard, track1_116.mcc2020_cnf
     //   and blasted_TR_b14_even3_linear.cnf.gz.no_w.cnf
@@ -634,7 +849,67 @@ Arjun::get_fully_simplified_renumbered_cnf(
     vector<uint32_t> new_sampl_set;
     for(const auto& l: dont_elim) new_sampl_set.push_back(l.var());
     auto cnf = get_simplified_renumbered_cnf(&solver, new_sampl_set);
-    return std::make_tuple(cnf, new_sampl_set, empty_vars.size());
+
+    // Carry the groups through the renumbering. Groups are
+    // renumbered in the order they are first seen, and variables that got
+    // replaced by an equivalent one only appear once. SCC replacement can
+    // merge sampling variables of different groups into one new variable,
+    // and CMS can't be told not to, so such groups are merged: taking the
+    // merged group in or out is still sound, it may just not be minimal.
+    vector<vector<uint32_t>> new_groups(1);
+    if (arjdata->common.conf.group_indep) {
+        const auto& var2grp = arjdata->common.var2var_group;
+        assert(new_sampl_set.size() == dont_elim.size());
+
+        // Old group of each sampling var, and union-find over the old groups
+        vector<uint32_t> grp_of(dont_elim.size(), 0);
+        map<uint32_t, uint32_t> parent;
+        auto find = [&](uint32_t g) {
+            while(parent.count(g) && parent[g] != g) g = parent[g];
+            return g;
+        };
+        map<uint32_t, uint32_t> new_var_grp;
+        uint32_t num_merged = 0;
+        for(uint32_t i = 0; i < dont_elim.size(); i++) {
+            const uint32_t orig_var = back_map[dont_elim[i].var()];
+            if (orig_var >= var2grp.size() || var2grp[orig_var] == 0) continue;
+            grp_of[i] = var2grp[orig_var];
+
+            auto it = new_var_grp.find(new_sampl_set[i]);
+            if (it == new_var_grp.end()) {
+                new_var_grp[new_sampl_set[i]] = grp_of[i];
+                continue;
+            }
+            const uint32_t r1 = find(it->second);
+            const uint32_t r2 = find(grp_of[i]);
+            if (r1 != r2) {
+                parent[std::max(r1, r2)] = std::min(r1, r2);
+                num_merged++;
+            }
+        }
+        if (num_merged && arjdata->common.conf.verb) {
+            cout << "c [arjun] renumbering made " << num_merged
+            << " groups share a variable with another, merged them" << endl;
+        }
+
+        map<uint32_t, uint32_t> old_to_new_group;
+        for(uint32_t i = 0; i < dont_elim.size(); i++) {
+            if (grp_of[i] == 0) continue;
+            const uint32_t group = find(grp_of[i]);
+            auto it = old_to_new_group.find(group);
+            if (it == old_to_new_group.end()) {
+                it = old_to_new_group.insert(std::make_pair(group, (uint32_t)new_groups.size())).first;
+                new_groups.push_back(vector<uint32_t>());
+            }
+            new_groups[it->second].push_back(new_sampl_set[i]);
+        }
+        for(auto& g: new_groups) {
+            std::sort(g.begin(), g.end());
+            g.erase(std::unique(g.begin(), g.end()), g.end());
+        }
+    }
+
+    return std::make_tuple(cnf, new_sampl_set, empty_vars.size(), new_groups);
 }
 
 // DLL_PUBLIC void Arjun::set_polar_mode(CMSat::PolarityMode mode)
@@ -668,8 +943,10 @@ DLL_PUBLIC void Arjun::set_variable_groups(
   const std::vector<std::vector<uint32_t>>& _var_groups)
 {   
     arjdata->common.var2var_group = _var2var_group;
-    cout << "c [gismo] set var2var_group, insize = " << _var2var_group.size()
-         << ", outsize = " << arjdata->common.var2var_group.size() << endl;
+    if (arjdata->common.conf.verb) {
+        cout << "c [gismo] set var2var_group, insize = " << _var2var_group.size()
+             << ", outsize = " << arjdata->common.var2var_group.size() << endl;
+    }
     arjdata->common.var_groups = _var_groups;
 }
 
@@ -678,6 +955,17 @@ DLL_PUBLIC void Arjun::set_group_independent_support(uint32_t group_indep)
     arjdata->common.conf.group_indep = group_indep;
 }
 
+DLL_PUBLIC uint32_t Arjun::get_group_independent_support() const
+{
+    return arjdata->common.conf.group_indep;
+}
+
+DLL_PUBLIC uint32_t Arjun::get_var_group(uint32_t var) const
+{
+    if (var >= arjdata->common.var2var_group.size()) return 0;
+    return arjdata->common.var2var_group[var];
+}
+
 DLL_PUBLIC void Arjun::print_var_groups()
 {
     cout << "c [gismo] GROUPS:" << endl;
@@ -24,15 +24,91 @@ THE SOFTWARE.
 #define ARJUN_H__
 
 #include <cstdint>
+#include <cstddef>
 #include <vector>
 #include <utility>
 #include <string>
 #include <tuple>
+#include <functional>
 #include <cryptominisat5/cryptominisat.h>
 #include <cryptominisat5/solvertypesmini.h>
 
 namespace ArjunNS {
+    /** Cost of one phase of get_indep_set(), in the order they ran */
+    struct PhaseStat {
+        std::string name;
+        double wall_time = 0;
+        double cpu_time = 0;
+        uint64_t conflicts = 0;
+        uint64_t propagations = 0;
+        //resident set size, in bytes
+        int64_t rss_delta = 0;
+        uint64_t rss_peak = 0;
+        //Outcome of the solver calls, for forward and backward
+        uint64_t ret_true = 0;
+        uint64_t ret_false = 0;
+        uint64_t ret_undef = 0;
+        //Hardware counters, if they were asked for and could be read.
+        //A counter the CPU doesn't have stays 0
+        bool hw_counters = false;
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t llc_misses = 0;
+        uint64_t branch_misses = 0;
+    };
+
+    struct RunStats {
+        std::vector<PhaseStat> phases;
+        uint64_t conflicts = 0;
+        uint64_t mem_peak = 0; //resident set size, in bytes
+        //get_indep_set() was stopped by interrupt_asap(), the progress
+        //callback, or running out of the time, conflict or memory limit, so
+        //the set it returned is independent, but may not be minimal
+        bool interrupted = false;
+    };
+
+    /** Syntactic features of the formula, see get_instance_features() */
+    struct InstanceFeatures {
+        uint32_t num_vars = 0;
+        uint64_t num_clauses = 0;
+        uint64_t num_bin_clauses = 0;
+        uint64_t num_lits = 0;
+        uint32_t num_bnns = 0;
+        uint32_t sampling_set_size = 0;
+        //Non-empty groups, in group mode
+        uint32_t num_groups = 0;
+        uint32_t max_group_size = 0;
+        double avg_group_size = 0;
+        //XORs over 2..5 variables, and y = OR(x_1..x_k) gates, k <= 63,
+        //spelled out as clauses
+        uint32_t num_xors = 0;
+        uint32_t num_or_gates = 0;
+        //Occurrences of the variables in clauses and BNNs
+        double avg_var_degree = 0;
+        uint32_t max_var_degree = 0;
+        double var_degree_cv = 0; //standard deviation / mean
+    };
+
+    /** Passed to the progress callback between two solver calls of guess,
+     * forward and backward */
+    struct Progress {
+        const char* phase = ""; //"guess", "forward" or "backward"
+        //Groups (or variables outside of groups) decided in this phase, and
+        //still to be decided. For guess: variables removed so far by the
+        //phase, and variables left to try
+        uint64_t decided = 0;
+        uint64_t remaining = 0;
+        //Returns the set get_indep_set() would return if stopped now. It is
+        //independent, and shrinks as the search goes on. Computed when
+        //called, in time linear in the number of variables
+        std::function<std::vector<uint32_t>()> upper_bound;
+    };
+
     struct ArjPrivateData;
+    /** Separate instances share no state, and may be used from separate
+     * threads at the same time. One instance must only be used by one thread
+     * at a time, except for interrupt_asap(). For a C interface, see
+     * gismo_c.h */
     #ifdef _WIN32
     class __declspec(dllexport) Arjun
     #else
@@ -40,8 +116,33 @@ namespace ArjunNS {
     #endif
     {
     public:
+        /** Called with a group index and its variables whenever that group is
+         * known to be part of the independent set. Variables that are not in
+         * any group are reported one at a time, with group index 0. Called
+         * once more with done = TRUE at the end, with group index 0 and the
+         * set get_indep_set() returns.
+         *
+         * Groups reported are not taken back, but may still be missing from
+         * the final set: it is empty if the formula turned out to be UNSAT,
+         * and a later get_indep_set() after edits reports its own groups
+         * again from scratch. Only the set given with done = TRUE is final. */
+        typedef std::function<void(uint32_t group, const std::vector<uint32_t>& vars, bool done)> IndepCallback;
+        /** Called between two solver calls of guess, forward and backward.
+         * Returning FALSE stops the search as interrupt_asap() does. */
+        typedef std::function<bool(const Progress& progress)> ProgressCallback;
+
         Arjun();
         ~Arjun();
+        /** Forgets the formula, sampling set, groups, hint and the result and
+         * statistics of the last run, as if newly constructed, but keeps the
+         * configuration, the callbacks, and the memory already allocated, so
+         * that running many small instances one after the other doesn't
+         * allocate anew for each. The solver itself is made anew, so what was
+         * given to set_pred_forever_cutoff() and set_every_pred_reduce() must
+         * be given again. A query log being recorded is closed, as its
+         * queries belong to the old formula. Not to be called while
+         * get_indep_set() runs. */
+        void reset();
         std::string get_version_info();
         std::string get_compilation_env();
         std::string get_solver_version_info();
@@ -57,6 +158,46 @@ namespace ArjunNS {
             CMSat::Lit out = CMSat::lit_Undef);
         void new_vars(uint32_t num);
 
+        /** Adds a clause that can be taken back with remove_clause() and the
+         * id returned, or switched off and on with set_clause_active(). It
+         * gets an activation variable of its own, which is never in the
+         * independent set. Returns UINT32_MAX if the clause has a variable
+         * that did not exist when get_indep_set() was first called.
+         *
+         * Once get_indep_set() was called, add_clause(), add_removable_clause(),
+         * set_clause_active() and remove_clause() edit the formula in place,
+         * and the next get_indep_set() keeps the solver with its learnt
+         * clauses, starts from the previous set, and only re-tests the groups
+         * in the parts of the formula the edits touched. XOR and BNN
+         * constraints, and new variables, can only be added before the first
+         * get_indep_set(): afterwards add_xor_clause() and add_bnn_clause()
+         * return FALSE, and new_var() and new_vars() do nothing. */
+        uint32_t add_removable_clause(
+            const std::vector<CMSat::Lit>& lits,
+            bool active = true);
+        bool set_clause_active(uint32_t id, bool active);
+        bool remove_clause(uint32_t id);
+
+        /** Parse a (grouped) DIMACS CNF held in memory, of length len. The
+         * "c ind" line sets the sampling set (or all variables are used if
+         * there is none, or recompute_sampling_set is set), and in group
+         * mode the "c grp" lines set the variable groups, exactly as the
+         * command-line tool does. Returns FALSE on a parse error. */
+        bool parse_dimacs_buffer(
+            const char* data,
+            size_t len,
+            uint32_t& sampling_set_size,
+            bool recompute_sampling_set = false);
+        /** Same for an undirected graph given as an edge list, building the
+         * identifying code encoding with at most k TRUE nodes, exactly as
+         * --edges of the command-line tool does. */
+        bool parse_edges_buffer(
+            const char* data,
+            size_t len,
+            uint32_t k,
+            bool use_bnn,
+            uint32_t& sampling_set_size);
+
         // Perform indep set calculation
         uint32_t set_starting_sampling_set(const std::vector<uint32_t>& vars);
         uint32_t start_with_clean_sampling_set();
@@ -64,10 +205,53 @@ namespace ArjunNS {
         uint32_t get_orig_num_vars() const;
         void varreplace();
         std::vector<uint32_t> get_empty_occ_sampl_vars() const;
+        /** Call once the formula, sampling set and groups are set, before
+         * get_indep_set(). Linear in the size of the formula */
+        InstanceFeatures get_instance_features();
+        void set_indep_callback(IndepCallback cb);
+        void set_progress_callback(ProgressCallback cb);
+        /** A candidate independent set, e.g. from an earlier run with another
+         * k or a slightly different graph. Backward tests the groups outside
+         * of it first, as they are likely dependent, and verifies the groups
+         * in it last. If verified_superset is set, the caller guarantees that
+         * the hint is independent, and only its groups are tested. In group
+         * mode, a group is in the hint if any of its variables is. */
+        void set_hint_indep_set(
+            const std::vector<uint32_t>& vars,
+            bool verified_superset = false);
+        /** Makes the running (or next) get_indep_set() return as soon as its
+         * current solver call is done. Groups not yet decided are kept, so
+         * the set returned is still independent, but may not be minimal.
+         * Safe to call from another thread. */
+        void interrupt_asap();
+        RunStats get_run_stats() const;
+
+        /** Record a timeline of the phases, rounds and (every
+         * trace_solve_every-th) solver call into a ring of capacity spans,
+         * allocated here. write_trace() writes it in Chrome Trace Event
+         * format, for chrome://tracing or ui.perfetto.dev. */
+        void start_trace(size_t capacity = 1U << 16);
+        bool write_trace(const std::string& fname) const;
+
+        /** Log every oracle query of guess, forward and backward (assumptions,
+         * budget, outcome and cost) to fname, in a compact binary format.
+         * Call after the formula has been added. replay_queries() re-issues
+         * the queries of such a log on this formula, freshly duplicated with
+         * the current configuration, with the recorded budgets, or with
+         * max_confl if it's not negative, and prints how the outcomes and
+         * the costs compare. Use it instead of get_indep_set().
+         *
+         * The log stays open until record_queries("") or reset() closes it,
+         * or the object is destroyed, and is written out at the end of every
+         * get_indep_set(). Later runs on the same formula, e.g. after clause
+         * edits, append to it. */
+        bool record_queries(const std::string& fname);
+        bool replay_queries(const std::string& fname, int64_t max_confl = -1);
 
         // by anna; For group independent support
         /** by anna; maps variable name to the index of the variable group that
-         * it is a member of. */
+         * it is a member of. Not read by the library, the groups are only set
+         * by set_variable_groups(). */
         std::vector<uint32_t> var2var_group;
         /** by anna; maps variable group index to the variable names that are
          * members of that group. */
@@ -78,6 +262,9 @@ namespace ArjunNS {
           const std::vector<std::vector<uint32_t>>& _var_groups);
         /** by anna */
         void set_group_independent_support(uint32_t group_ind);
+        uint32_t get_group_independent_support() const;
+        /** Returns 0 if the variable is in no group */
+        uint32_t get_var_group(uint32_t var) const;
         /** by anna; for debugging purposes only. TODO: remove when done. */
         void print_var_groups(); // by anna
 
@@ -86,7 +273,12 @@ namespace ArjunNS {
         bool get_next_small_clause(std::vector<CMSat::Lit>& ret); //returns FALSE if no more
         void end_getting_small_clauses();
         const std::vector<CMSat::Lit> get_simplified_cnf() const;
-        std::tuple<std::pair<std::vector<std::vector<CMSat::Lit>>, uint32_t>, std::vector<uint32_t>, uint32_t>
+        /** Returns the CNF with its number of variables, the renumbered
+         * sampling set, the number of empty variables removed, and in group
+         * mode the renumbered groups of the sampling set (indexed from 1,
+         * group 0 is always empty). Groups whose variables got replaced by
+         * the same one are merged, so the groups are always disjoint. */
+        std::tuple<std::pair<std::vector<std::vector<CMSat::Lit>>, uint32_t>, std::vector<uint32_t>, uint32_t, std::vector<std::vector<uint32_t>>>
             get_fully_simplified_renumbered_cnf(
             const std::vector<uint32_t>& sampl_set,
             const std::vector<uint32_t>& empty_vars,
@@ -112,6 +304,14 @@ namespace ArjunNS {
         void set_backward(bool backward);
         void set_assign_fwd_val(bool assign_fwd_val);
         void set_backw_max_confl(uint32_t backw_max_confl);
+        void set_trace_solve_every(uint32_t trace_solve_every);
+        void set_perf_counters(bool perf_counters);
+        void set_heartbeat(double heartbeat);
+        //Limits of get_indep_set(), 0 is unlimited. When one runs out, the
+        //independent set found so far is returned
+        void set_time_limit(double seconds);
+        void set_conflict_budget_total(uint64_t conflicts);
+        void set_memory_limit(uint64_t bytes);
         void set_gauss_jordan(bool gauss_jordan);
         void set_regularly_simplify(bool reg_simp);
         void set_fwd_group(uint32_t forward_group);
@@ -121,6 +321,7 @@ namespace ArjunNS {
         void set_irreg_gate_based(const bool irreg_gate_based);
         void set_gate_sort_special(bool gate_sort_special);
         void set_backbone_simpl_max_confl(uint64_t backbone_simpl_max_confl);
+        void set_guess_max_confl(uint32_t guess_max_confl);
         //void set_polar_mode(CMSat::PolarityMode mode);
         void set_pred_forever_cutoff(int pred_forever_cutoff = -1);
         void set_every_pred_reduce(int every_pred_reduce = -1);
@@ -142,6 +343,12 @@ namespace ArjunNS {
         bool get_backward() const;
         bool get_assign_fwd_val() const;
         uint32_t get_backw_max_confl() const;
+        uint32_t get_trace_solve_every() const;
+        bool get_perf_counters() const;
+        double get_heartbeat() const;
+        double get_time_limit() const;
+        uint64_t get_conflict_budget_total() const;
+        uint64_t get_memory_limit() const;
         bool get_gauss_jordan() const;
         bool get_regularly_simplify() const;
         uint32_t get_fwd_group() const;
@@ -152,6 +359,7 @@ namespace ArjunNS {
         bool get_gate_sort_special() const;
 
         long unsigned get_backbone_simpl_max_confl() const;
+        uint32_t get_guess_max_confl() const;
 
     private:
         ArjPrivateData* arjdata = NULL;
@@ -0,0 +1,257 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "asynclog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+using std::string;
+
+AsyncLog& AsyncLog::get()
+{
+    //Never destroyed: Arjun objects may log from static destructors.
+    //The writer is stopped and drained from an atexit() handler instead.
+    static AsyncLog* log = new AsyncLog;
+    return *log;
+}
+
+AsyncLog::AsyncLog() :
+    slots(new Slot[num_slots]),
+    enqueue_pos(0),
+    dequeue_pos(0),
+    written(0),
+    lines(0),
+    running(false),
+    stopping(false),
+    stopped(false),
+    sleeping(false),
+    wake_mutex(new std::mutex),
+    wake_cv(new std::condition_variable)
+{
+    for(size_t i = 0; i < num_slots; i++) {
+        slots[i].seq.store(i, std::memory_order_relaxed);
+        slots[i].len = 0;
+    }
+}
+
+static void stop_async_log_at_exit()
+{
+    AsyncLog::get().shutdown();
+}
+
+void AsyncLog::forked_child()
+{
+    //The writer thread is not copied by fork(). Forget about it (its
+    //std::thread object must not be joined or destroyed) and start a new
+    //one in the child when it first logs.
+    //Lines still queued belong to the parent, which writes them itself.
+    AsyncLog& l = get();
+    l.writer = NULL;
+    l.running.store(false);
+    l.sleeping.store(false);
+    l.wake_mutex = new std::mutex;
+    l.wake_cv = new std::condition_variable;
+    for(size_t i = 0; i < num_slots; i++) l.slots[i].seq.store(i);
+    l.enqueue_pos.store(0);
+    l.dequeue_pos.store(0);
+    l.written.store(0);
+}
+
+void AsyncLog::start_writer()
+{
+    std::lock_guard<std::mutex> lock(start_mutex);
+    if (running.load() || stopped.load()) return;
+
+    static bool registered = false;
+    if (!registered) {
+        registered = true;
+        std::atexit(stop_async_log_at_exit);
+        #ifndef _WIN32
+        pthread_atfork(NULL, NULL, forked_child);
+        #endif
+    }
+    stopping.store(false);
+    writer = new std::thread(&AsyncLog::writer_loop, this);
+    running.store(true);
+}
+
+bool AsyncLog::try_push(const char* data, size_t len)
+{
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    while(true) {
+        Slot& s = slots[pos & (num_slots-1)];
+        const size_t seq = s.seq.load(std::memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) {
+                memcpy(s.data, data, len);
+                s.len = len;
+                s.seq.store(pos+1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            //Full
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void AsyncLog::push(const char* data, size_t len)
+{
+    lines.fetch_add(1, std::memory_order_relaxed);
+    if (stopped.load(std::memory_order_acquire)) {
+        fwrite(data, 1, len, stdout);
+        return;
+    }
+    if (!running.load(std::memory_order_acquire)) start_writer();
+
+    while(len > 0) {
+        const size_t chunk = std::min(len, slot_bytes);
+        uint32_t spins = 0;
+        while(!try_push(data, chunk)) {
+            //Full, wait for the writer. If it was shut down meanwhile,
+            //nobody will empty the queue any more.
+            if (stopped.load(std::memory_order_acquire)) {
+                fwrite(data, 1, len, stdout);
+                return;
+            }
+            if (++spins < 64) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        data += chunk;
+        len -= chunk;
+    }
+    //Pairs with the fence in sleep_until_pushed(): either the writer sees
+    //the line, or this sees it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) wake_writer();
+}
+
+bool AsyncLog::has_queued() const
+{
+    const size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    const Slot& s = slots[pos & (num_slots-1)];
+    return (intptr_t)s.seq.load(std::memory_order_acquire) - (intptr_t)(pos+1) >= 0;
+}
+
+void AsyncLog::wake_writer()
+{
+    std::lock_guard<std::mutex> lock(*wake_mutex);
+    sleeping.store(false, std::memory_order_relaxed);
+    wake_cv->notify_one();
+}
+
+void AsyncLog::sleep_until_pushed()
+{
+    std::unique_lock<std::mutex> lock(*wake_mutex);
+    sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (has_queued() || stopping.load()) {
+        sleeping.store(false, std::memory_order_relaxed);
+        return;
+    }
+    wake_cv->wait(lock, [&]{ return !sleeping.load(std::memory_order_relaxed); });
+}
+
+bool AsyncLog::try_pop(string& out)
+{
+    //Single consumer, no CAS needed
+    const size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    Slot& s = slots[pos & (num_slots-1)];
+    const size_t seq = s.seq.load(std::memory_order_acquire);
+    if ((intptr_t)seq - (intptr_t)(pos+1) < 0) return false;
+
+    out.append(s.data, s.len);
+    s.seq.store(pos + num_slots, std::memory_order_release);
+    dequeue_pos.store(pos+1, std::memory_order_relaxed);
+    return true;
+}
+
+void AsyncLog::writer_loop()
+{
+    string buf;
+    buf.reserve(1U << 16);
+    uint32_t idle = 0;
+    while(true) {
+        size_t got = 0;
+        while(buf.size() < (1U << 16) && try_pop(buf)) got++;
+
+        if (got > 0) {
+            fwrite(buf.data(), 1, buf.size(), stdout);
+            buf.clear();
+            written.fetch_add(got, std::memory_order_release);
+            idle = 0;
+            continue;
+        }
+
+        //Nothing queued: make what was written visible, then back off
+        if (idle == 0) fflush(stdout);
+        if (stopping.load(std::memory_order_acquire)
+            && dequeue_pos.load() == enqueue_pos.load())
+        {
+            break;
+        }
+        idle++;
+        if (idle < 64) std::this_thread::yield();
+        else sleep_until_pushed();
+    }
+    fflush(stdout);
+}
+
+void AsyncLog::flush()
+{
+    if (!running.load(std::memory_order_acquire)) return;
+
+    const size_t target = enqueue_pos.load();
+    if (written.load(std::memory_order_acquire) >= target) return;
+    while(written.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    fflush(stdout);
+}
+
+void AsyncLog::shutdown()
+{
+    std::lock_guard<std::mutex> lock(start_mutex);
+    stopped.store(true);
+    if (!running.load()) return;
+
+    stopping.store(true, std::memory_order_release);
+    wake_writer();
+    writer->join();
+    delete writer;
+    writer = NULL;
+    running.store(false);
+}
@@ -0,0 +1,114 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_ASYNCLOG_H
+#define ARJUN_ASYNCLOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Highest verbosity level whose log_print() calls are compiled in at all.
+// Anything above it costs nothing at run time, not even the verbosity check.
+#ifndef ARJUN_MAX_LOG_LEVEL
+#define ARJUN_MAX_LOG_LEVEL 10
+#endif
+
+// log_print: like verb_print, but for messages inside loops that run once per
+// variable or solver call. The line is only formatted when both the compile
+// time and the run time (conf.verb) level allow it, and it is then handed to
+// a background thread, so the caller never waits for the terminal or a pipe.
+#define log_print(a, x) \
+    do { if ((a) <= ARJUN_MAX_LOG_LEVEL && conf.verb >= (a)) { \
+        std::ostringstream log_ss_; log_ss_ << "c " << x << '\n'; \
+        AsyncLog::get().push(log_ss_.str()); } } while (0)
+
+// Process-wide, bounded, multi-producer log queue drained to stdout by one
+// background thread. Producers claim a slot with a single CAS and never take
+// a lock; when the queue is full they back off until the writer catches up,
+// so nothing is dropped. Lines longer than a slot are split over several
+// slots. flush() returns once everything pushed so far is written, call it
+// before printing to std::cout directly so the two stay in order. An idle
+// writer sleeps on a condition variable, producers only take its mutex to
+// wake it up.
+class AsyncLog
+{
+public:
+    static AsyncLog& get();
+
+    void push(const std::string& msg) { push(msg.data(), msg.size()); }
+    void push(const char* data, size_t len);
+    void flush();
+
+    //Drain, stop the writer thread and write any later lines synchronously
+    void shutdown();
+
+    uint64_t num_lines() const { return lines.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t num_slots = 1U << 12;
+    static constexpr size_t slot_bytes = 248;
+    struct Slot {
+        std::atomic<size_t> seq;
+        uint32_t len;
+        char data[slot_bytes];
+    };
+
+    AsyncLog();
+    bool try_push(const char* data, size_t len);
+    bool try_pop(std::string& out);
+    bool has_queued() const;
+    void wake_writer();
+    void sleep_until_pushed();
+    void start_writer();
+    void writer_loop();
+    static void forked_child();
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<size_t> enqueue_pos;
+    std::atomic<size_t> dequeue_pos;
+    std::atomic<size_t> written;
+    std::atomic<uint64_t> lines;
+    std::atomic<bool> running;
+    std::atomic<bool> stopping;
+    std::atomic<bool> stopped;
+    std::mutex start_mutex;
+    std::thread* writer = NULL;
+
+    //Pointers, so that a child after fork() can forget the parent's, which
+    //the writer may have held at the time
+    std::atomic<bool> sleeping;
+    std::mutex* wake_mutex;
+    std::condition_variable* wake_cv;
+};
+
+#endif //ARJUN_ASYNCLOG_H
@@ -25,6 +25,7 @@
  */
 
 #include "common.h"
+#include "heartbeat.h"
 
 void Common::fill_assumptions_backward(
     vector<Lit>& assumptions,
@@ -80,23 +81,60 @@ void Common::fill_assumptions_backward(
             assumptions.push_back(Lit(indic, true));
         }
 
-        if (conf.verb > 5) {
-            cout << "Filled assump with unknown: " << var << endl;
-        }
+        log_print(6, "Filled assump with unknown: " << var);
     }
     unknown.resize(j);
 }
 
-void Common::backward_round()
+void Common::mark_hinted(vector<char>& hinted) const
+{
+    hinted.assign(orig_num_vars, 0);
+    for(const auto& v: hint) if (v < orig_num_vars) hinted[v] = 1;
+    if (!conf.group_indep) return;
+    for(uint32_t g = 1; g < var_groups.size(); g++) {
+        bool any = false;
+        for(const auto& v: var_groups[g]) any |= (bool)hinted[v];
+        if (!any) continue;
+        for(const auto& v: var_groups[g]) hinted[v] = 1;
+    }
+}
+
+// Backward tests from the end of unknown, so the groups outside of the hint
+// are moved there, keeping the order (and the groups together) otherwise
+void Common::order_by_hint(vector<uint32_t>& unknown) const
+{
+    vector<char> hinted;
+    mark_hinted(hinted);
+    std::stable_partition(unknown.begin(), unknown.end(),
+        [&](const uint32_t v) { return hinted[v]; });
+}
+
+void Common::restrict_to_hint()
+{
+    vector<char> hinted;
+    mark_hinted(hinted);
+    const size_t old_size = sampling_set->size();
+    other_sampling_set->clear();
+    for(const auto& v: *sampling_set) {
+        if (hinted[v]) other_sampling_set->push_back(v);
+    }
+    std::swap(sampling_set, other_sampling_set);
+    verb_print(1, "[arjun] restricted to the hint, set size: "
+        << old_size << " -> " << sampling_set->size());
+}
+
+// Variables in known_indep are put in the set as they are, without testing
+void Common::backward_round(const vector<uint32_t>& known_indep)
 {
     for(const auto& x: seen) assert(x == 0);
 
     double start_round_time = cpuTimeTotal();
-    //start with empty independent set
-    vector<uint32_t> indep;
+    PhaseTimer timer(this, "backward");
+    vector<uint32_t> indep(known_indep);
     vector<uint32_t> unknown;
     vector<char> unknown_set;
     unknown_set.resize(orig_num_vars, 0);
+    uint64_t remaining = 0; //groups, or variables outside of groups
     for(const auto& x: *sampling_set) {
         assert(x < orig_num_vars);
         // Check if the variable is a member of a group.
@@ -105,6 +143,7 @@ void Common::backward_round()
         // The unknown_set corresponds to $Q$ in the pseudocode in Algorithm 1
         // in our paper.
         if (conf.group_indep && in_variable_group(x)) {
+            remaining += unknown_set[x] == 0;
             for (auto& grp_var: var_groups[get_group_idx(x)]) {
                 if (unknown_set[grp_var] == 0) {
                     unknown.push_back(grp_var);
@@ -115,15 +154,17 @@ void Common::backward_round()
             assert(unknown_set[x] == 0 && "No var should be in 'sampling_set' twice!");
             unknown.push_back(x);
             unknown_set[x] = 1;
+            remaining++;
         }
     }
 
     // TODO: bring back sorting! But respecting the groups!
     if (conf.group_indep) {
-        cout << "c [arjun] WARNING: no sorting in grouped independent support setting!" << endl;
+        verb_print(1, "[arjun] WARNING: no sorting in grouped independent support setting!");
     } else {
         sort_unknown(unknown);
     }
+    if (!hint.empty()) order_by_hint(unknown);
     if (conf.verb >= 4) {
         cout << "Sorted output: "<< endl;
         for (const auto& v:unknown) {
@@ -144,6 +185,7 @@ void Common::backward_round()
     uint32_t not_indep = 0;
 
     double myTime = cpuTime();
+    uint64_t block_start = tracer ? tracer->now() : 0;
 
     //Calc mod:
     uint32_t mod = 1;
@@ -157,13 +199,23 @@ void Common::backward_round()
     uint32_t ret_false = 0;
     uint32_t ret_true = 0;
     uint32_t ret_undef = 0;
+    uint64_t all_true = 0;
+    uint64_t all_false = 0;
+    uint64_t all_undef = 0;
     uint32_t fast_backw_calls = 0;
     uint32_t fast_backw_max = 0;
     uint32_t fast_backw_tot = 0;
     vector<uint32_t> non_indep_vars;
+    Heartbeat heartbeat(conf.verb ? conf.heartbeat : 0, conf.group_indep ? "groups" : "vars");
+    uint64_t decided = 0;
 
     while(true) {
         uint32_t test_var = var_Undef;
+        if (interrupted()) {
+            //What's still unknown stays in the set
+            verb_print(1, "[arjun] backward interrupted, unknown left: " << remaining);
+            break;
+        }
 
         while(!unknown.empty()) {
             uint32_t var = unknown[unknown.size()-1];
@@ -190,7 +242,7 @@ void Common::backward_round()
         }
 
         if (test_var == var_Undef) {
-            cout << "c [arjun] we are done, backward is finished" << endl;
+            verb_print(1, "[arjun] we are done, backward is finished");
             break;
         }
 
@@ -217,29 +269,30 @@ void Common::backward_round()
             for (auto& v: var_groups[get_group_idx(test_var)]) {
                 assumptions.push_back(Lit(v, false));
                 assumptions.push_back(Lit(v + orig_num_vars, true));
-                solver->set_max_confl(conf.backw_max_confl);
-                ret = solver->solve(&assumptions);
+                ret = oracle_solve(assumptions, conf.backw_max_confl, oracle_backward);
                 if (ret == l_Undef || ret == l_True) break;
                 assumptions.resize(orig_ass_size);
             }
         } else {
             assumptions.push_back(Lit(test_var, false));
             assumptions.push_back(Lit(test_var + orig_num_vars, true));
-            solver->set_max_confl(conf.backw_max_confl);
-            ret = solver->solve(&assumptions);
+            ret = oracle_solve(assumptions, conf.backw_max_confl, oracle_backward);
         }
         solver->set_no_confl_needed();
         
         // TODO: make grouped variables compatible with fast_backw
         if (ret == l_False) {
             ret_false++;
-            if (conf.verb >= 5) cout << "c [arjun] backw solve(): False" << endl;
+            all_false++;
+            log_print(5, "[arjun] backw solve(): False");
         } else if (ret == l_True) {
             ret_true++;
-            if (conf.verb >= 5) cout << "c [arjun] backw solve(): True" << endl;
+            all_true++;
+            log_print(5, "[arjun] backw solve(): True");
         } else if (ret == l_Undef) {
-            if (conf.verb >= 5) cout << "c [arjun] backw solve(): Undef" << endl;
+            log_print(5, "[arjun] backw solve(): Undef");
             ret_undef++;
+            all_undef++;
         }
 
         // TODO: come up with an equivalent assertion for group mode.
@@ -256,21 +309,35 @@ void Common::backward_round()
             // group to the independent support. This corresponds to line 8
             // of Algorithm 1 in our paper
             if (in_variable_group(test_var)) {
-                cout << "Group " <<  var2var_group[test_var] << " is independent" << endl;
+                log_print(2, "Group " << var2var_group[test_var] << " is independent");
                 for (auto& grp_var: var_groups[get_group_idx(test_var)]) {
                     indep.push_back(grp_var);
                 }
             } else {
                 indep.push_back(test_var);
             }
+            report_indep(test_var);
         } else if (ret == l_False) {
             //not independent
             //i.e. given that all in indep+unkown is equivalent, it's not possible that a1 != b1
             not_indep++;
         }
+        decided++;
+        if (remaining > 0) remaining--;
+        if (heartbeat.due()) heartbeat.beat(decided, remaining);
+        report_progress("backward", decided, remaining,
+            [&](vector<uint32_t>& bound) {
+                for(const auto& v: unknown) if (unknown_set[v]) bound.push_back(v);
+                bound.insert(bound.end(), indep.begin(), indep.end());
+            });
 
+        if (tracer && iter % mod == (mod-1)) {
+            tracer->span("backward_block", "iter", block_start, iter);
+            block_start = tracer->now();
+        }
         if (iter % mod == (mod-1) && conf.verb) {
             //solver->remove_and_clean_all();
+            AsyncLog::get().flush();
             cout
             << "c [arjun] iter: " << std::setw(5) << iter;
             if (mod == 1) {
@@ -312,6 +379,11 @@ void Common::backward_round()
     }
     update_sampling_set(unknown, unknown_set, indep);
 
+    ArjunNS::PhaseStat& ps = timer.stat();
+    ps.ret_true = all_true;
+    ps.ret_false = all_false;
+    ps.ret_undef = all_undef;
+    AsyncLog::get().flush();
     if (conf.verb) {
         cout << "c [arjun] backward round finished T: "
         << std::setprecision(2) << std::fixed << (cpuTime() - start_round_time)
@@ -0,0 +1,261 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "batch.h"
+#include "presets.h"
+#include "readfile.h"
+#include "jsonstr.h"
+#include "time_mem.h"
+#include "arjun.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+struct BatchItem
+{
+    uint32_t idx; //line order in the list file
+    string fname;
+    uint64_t size;
+};
+
+struct BatchResult
+{
+    string status = "error";
+    uint32_t orig_sampling_set_size = 0;
+    vector<uint32_t> indep;
+    uint32_t indep_groups = 0;
+    uint32_t empty_occs = 0;
+    double wall_time = 0;
+    double cpu_time = 0;
+    uint64_t conflicts = 0;
+    uint64_t mem_peak = 0;
+};
+
+bool ends_with(const string& s, const string& suffix)
+{
+    return s.size() >= suffix.size()
+        && s.compare(s.size()-suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool read_list(const string& list_file, vector<BatchItem>& items)
+{
+    std::ifstream in(list_file.c_str());
+    if (!in) return false;
+    string line;
+    while(std::getline(in, line)) {
+        while(!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        BatchItem item;
+        item.idx = items.size();
+        item.fname = line;
+        struct stat st;
+        item.size = stat(line.c_str(), &st) == 0 ? st.st_size : 0;
+        items.push_back(item);
+    }
+    return true;
+}
+
+// The worker's Arjun is reset, not made anew, so that its buffers are
+// reused. As the largest instances come first, they rarely have to grow
+BatchResult run_one(const BatchItem& item, const BatchOptions& opts, ArjunNS::Arjun& arjun)
+{
+    BatchResult res;
+    string data;
+    if (!read_whole_file(item.fname, data)) return res;
+
+    const double start_wall = wallTime();
+    const double start_cpu = cpuTime(); //of this thread
+    arjun.reset();
+    bool ok;
+    if (ends_with(item.fname, ".edges") || ends_with(item.fname, ".edges.gz")) {
+        ok = arjun.parse_edges_buffer(data.data(), data.size(),
+            opts.idcode_k, opts.idcode_bnn, res.orig_sampling_set_size);
+    } else {
+        ok = arjun.parse_dimacs_buffer(data.data(), data.size(),
+            res.orig_sampling_set_size, opts.recompute_sampling_set);
+    }
+    if (!ok) return res;
+    string().swap(data);
+
+    res.indep = arjun.get_indep_set();
+    res.wall_time = wallTime() - start_wall;
+    res.cpu_time = cpuTime() - start_cpu;
+    res.empty_occs = arjun.get_empty_occ_sampl_vars().size();
+    std::set<uint32_t> groups;
+    for(const uint32_t v: res.indep) {
+        const uint32_t g = arjun.get_var_group(v);
+        //variables outside of any group count as a group of their own
+        groups.insert(g == 0 ? (1U << 31) + v : g);
+    }
+    res.indep_groups = groups.size();
+    const ArjunNS::RunStats stats = arjun.get_run_stats();
+    res.conflicts = stats.conflicts;
+    res.mem_peak = stats.mem_peak;
+    //Stopped by --timelimit and the like: independent, but maybe not minimal
+    res.status = stats.interrupted ? "timeout" : "ok";
+    return res;
+}
+
+string json_line(const BatchItem& item, const BatchResult& r)
+{
+    std::stringstream ss;
+    ss << std::setprecision(6) << std::fixed;
+    ss
+    << "{\"idx\": " << item.idx
+    << ", \"input\": " << json_str(item.fname)
+    << ", \"status\": " << json_str(r.status);
+    if (r.status != "error") {
+        ss
+        << ", \"orig_sampling_set_size\": " << r.orig_sampling_set_size
+        << ", \"indep_size\": " << r.indep.size()
+        << ", \"indep_groups\": " << r.indep_groups
+        << ", \"empty_occs\": " << r.empty_occs
+        << ", \"wall_time\": " << r.wall_time
+        << ", \"cpu_time\": " << r.cpu_time
+        << ", \"conflicts\": " << r.conflicts
+        << ", \"mem_peak\": " << r.mem_peak
+        << ", \"indep_vars\": [";
+        for(uint32_t i = 0; i < r.indep.size(); i++) {
+            ss << (i ? ", " : "") << r.indep[i]+1;
+        }
+        ss << "]";
+    }
+    ss << "}\n";
+    return ss.str();
+}
+
+}
+
+int run_batch(const BatchOptions& opts)
+{
+    vector<BatchItem> items;
+    if (!read_list(opts.list_file, items)) {
+        cerr << "ERROR! Could not open file '" << opts.list_file << "' for reading" << endl;
+        return -1;
+    }
+
+    std::ofstream outf;
+    if (!opts.out_file.empty()) {
+        outf.open(opts.out_file.c_str(), std::ios::out);
+        if (!outf) {
+            cerr << "ERROR! Could not open file '" << opts.out_file << "' for writing" << endl;
+            return -1;
+        }
+    }
+
+    //Largest first, the list order breaks ties
+    std::stable_sort(items.begin(), items.end(),
+        [](const BatchItem& a, const BatchItem& b) { return a.size > b.size; });
+
+    uint32_t jobs = opts.jobs;
+    if (jobs == 0) jobs = std::max(1U, std::thread::hardware_concurrency());
+    jobs = std::min<uint32_t>(jobs, std::max<size_t>(items.size(), 1));
+
+    //The per-instance output of the workers would be interleaved, so they
+    //only talk at high verbosity
+    Config conf = opts.conf;
+    if (conf.verb < 2) conf.verb = 0;
+
+    const int verb = opts.conf.verb;
+    if (verb) {
+        cout << "c [arjun-batch] instances: " << items.size()
+        << " jobs: " << jobs << endl;
+    }
+
+    std::atomic<size_t> next(0);
+    std::mutex out_mutex;
+    uint32_t num_done = 0;
+    uint32_t num_ok = 0;
+    double busy_time = 0;
+    const double start_wall = wallTime();
+
+    auto worker = [&]() {
+        ArjunNS::Arjun arjun;
+        set_arjun_config(arjun, conf);
+        while(true) {
+            const size_t at = next.fetch_add(1);
+            if (at >= items.size()) break;
+            const BatchItem& item = items[at];
+            const BatchResult res = run_one(item, opts, arjun);
+            const string line = json_line(item, res);
+
+            std::lock_guard<std::mutex> lock(out_mutex);
+            num_done++;
+            if (res.status == "ok") num_ok++;
+            busy_time += res.wall_time;
+            if (outf.is_open()) {
+                outf << line;
+            }
+            if (verb) {
+                cout << "c [arjun-batch] " << std::setw(6) << num_done << "/" << items.size()
+                << " " << std::setw(5) << res.status;
+                if (res.status != "error") {
+                    cout
+                    << " ind: " << std::setw(6) << res.indep.size()
+                    << " T: " << std::setprecision(2) << std::fixed << res.wall_time;
+                }
+                cout << " " << item.fname << endl;
+            }
+        }
+    };
+
+    vector<std::thread> threads;
+    for(uint32_t i = 1; i < jobs; i++) threads.push_back(std::thread(worker));
+    worker();
+    for(auto& t: threads) t.join();
+
+    const double total_wall = wallTime() - start_wall;
+    if (verb) {
+        cout << "c [arjun-batch] done. ok: " << num_ok << "/" << items.size()
+        << " T: " << std::setprecision(2) << std::fixed << total_wall
+        << " instances/s: " << (total_wall > 0 ? (double)num_done/total_wall : 0)
+        << " worker utilisation: " << std::setprecision(1)
+        << (total_wall > 0 ? busy_time/(total_wall*jobs)*100.0 : 0) << " %"
+        << endl;
+    }
+    if (outf.is_open() && !outf) {
+        cerr << "ERROR! Could not write file '" << opts.out_file << "'" << endl;
+        return -1;
+    }
+    return num_ok == items.size() ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_BATCH_H
+#define ARJUN_BATCH_H
+
+#include <string>
+#include "config.h"
+
+// Runs every instance of a list file (one path per line, empty lines and
+// lines starting with '#' are skipped) in this process, on a pool of worker
+// threads that each reuse one Arjun, reset between instances. Instances are
+// handed out largest file first, so that a big one picked up last doesn't
+// leave the other workers idle at the end. Files ending in .edges or .edges.gz are read
+// as edge lists, with idcode_k and idcode_bnn as for --edges.
+struct BatchOptions
+{
+    std::string list_file;
+    uint32_t jobs = 0; //0 means one per hardware thread
+    std::string out_file; //JSON Lines, one object per instance
+    uint32_t idcode_k = 1;
+    bool idcode_bnn = true;
+    bool recompute_sampling_set = false;
+    Config conf;
+};
+
+int run_batch(const BatchOptions& opts);
+
+#endif //ARJUN_BATCH_H
@@ -0,0 +1,496 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "benchcorpus.h"
+#include "presets.h"
+#include "time_mem.h"
+#include "arjun.h"
+#include "readfile.h"
+#include "jsonstr.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+static CorpusResult run_instance(const string& fname, const Config& conf)
+{
+    CorpusResult res;
+    res.status = "error";
+    string data;
+    if (!read_whole_file(fname, data)) return res;
+
+    const double start_wall = wallTime();
+    const double start_cpu = cpuTime();
+    ArjunNS::Arjun arjun;
+    set_arjun_config(arjun, conf);
+    uint32_t sampl_size;
+    if (!arjun.parse_dimacs_buffer(data.data(), data.size(), sampl_size)) return res;
+    string().swap(data);
+
+    const vector<uint32_t> indep = arjun.get_indep_set();
+    res.wall_time = wallTime() - start_wall;
+    res.cpu_time = cpuTime() - start_cpu;
+    res.indep_vars = indep.size();
+    std::set<uint32_t> groups;
+    for(const uint32_t v: indep) {
+        const uint32_t g = arjun.get_var_group(v);
+        //variables outside of any group count as a group of their own
+        groups.insert(g == 0 ? (1U << 31) + v : g);
+    }
+    res.indep_groups = groups.size();
+    const ArjunNS::RunStats stats = arjun.get_run_stats();
+    res.conflicts = stats.conflicts;
+    res.mem_peak = stats.mem_peak;
+    res.status = "ok";
+    return res;
+}
+
+#ifndef _WIN32
+static vector<string> list_instances(const string& dir)
+{
+    vector<string> ret;
+    DIR* d = opendir(dir.c_str());
+    if (d == NULL) return ret;
+    struct dirent* ent;
+    while((ent = readdir(d)) != NULL) {
+        if (ent->d_name[0] == '.') continue;
+        const string fname = dir + "/" + ent->d_name;
+        struct stat st;
+        if (stat(fname.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+        ret.push_back(fname);
+    }
+    closedir(d);
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+static bool write_all(int fd, const string& str)
+{
+    size_t at = 0;
+    while(at < str.size()) {
+        const ssize_t w = write(fd, str.data()+at, str.size()-at);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        at += w;
+    }
+    return true;
+}
+
+// Runs the instance in a child process, so that it can be killed when the
+// time is up, and a crash or running out of memory only loses this run
+static CorpusResult run_instance_limited(
+    const string& fname, const Config& conf, double timeout)
+{
+    CorpusResult res;
+    res.status = "error";
+    int fds[2];
+    if (pipe(fds) != 0) return res;
+
+    cout << std::flush;
+    const double start = wallTime();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return res;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        //Some of the library's output is not gated by verbosity
+        const int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+        const CorpusResult r = run_instance(fname, conf);
+        std::stringstream ss;
+        ss << std::setprecision(6) << std::fixed
+        << r.status << " " << r.wall_time << " " << r.cpu_time << " "
+        << r.indep_vars << " " << r.indep_groups << " "
+        << r.conflicts << " " << r.mem_peak << "\n";
+        write_all(fds[1], ss.str());
+        _exit(0);
+    }
+
+    close(fds[1]);
+    string out;
+    bool timed_out = false;
+    for(;;) {
+        const double left = timeout - (wallTime() - start);
+        if (left <= 0) {
+            timed_out = true;
+            break;
+        }
+        struct pollfd pfd;
+        pfd.fd = fds[0];
+        pfd.events = POLLIN;
+        const int ret = poll(&pfd, 1, (int)std::ceil(std::min(left, 3600.0)*1000));
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret < 0) break;
+        if (ret == 0) continue;
+        char buf[512];
+        const ssize_t r = read(fds[0], buf, sizeof(buf));
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) break;
+        out.append(buf, r);
+    }
+    close(fds[0]);
+    if (timed_out) kill(pid, SIGKILL);
+    int wstatus;
+    while(waitpid(pid, &wstatus, 0) < 0 && errno == EINTR) {}
+
+    if (timed_out) {
+        res.status = "timeout";
+        res.wall_time = timeout;
+        return res;
+    }
+    std::stringstream ss(out);
+    ss >> res.status >> res.wall_time >> res.cpu_time
+    >> res.indep_vars >> res.indep_groups >> res.conflicts >> res.mem_peak;
+    if (ss.fail()) res.status = "error";
+    return res;
+}
+#endif
+
+static string csv_field(const string& s)
+{
+    if (s.find_first_of(",\"\n") == string::npos) return s;
+    string ret = "\"";
+    for(const char c: s) {
+        if (c == '"') ret += '"';
+        ret += c;
+    }
+    return ret + "\"";
+}
+
+static vector<string> split_csv_line(const string& line)
+{
+    vector<string> fields;
+    string cur;
+    bool quoted = false;
+    for(size_t i = 0; i < line.size(); i++) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i+1 < line.size() && line[i+1] == '"') {
+                cur += '"';
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                cur += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back(cur);
+            cur.clear();
+        } else {
+            cur += c;
+        }
+    }
+    fields.push_back(cur);
+    return fields;
+}
+
+static const char* csv_header =
+    "instance,preset,status,wall_time,cpu_time,indep_vars,indep_groups,"
+    "conflicts,mem_peak_bytes,timeout";
+
+static string csv_line(const CorpusResult& r, double timeout)
+{
+    std::stringstream ss;
+    ss << std::setprecision(6) << std::fixed
+    << csv_field(r.instance) << ","
+    << csv_field(r.preset) << ","
+    << r.status << ","
+    << r.wall_time << ","
+    << r.cpu_time << ","
+    << r.indep_vars << ","
+    << r.indep_groups << ","
+    << r.conflicts << ","
+    << r.mem_peak << ","
+    << timeout;
+    return ss.str();
+}
+
+// Reads a database written by --bench-db. The timeout of the baseline run
+// is returned too, as PAR-2 is computed with it.
+static bool read_db(
+    const string& fname,
+    vector<CorpusResult>& results,
+    double& timeout)
+{
+    std::ifstream in(fname.c_str());
+    if (!in) return false;
+    string line;
+    if (!std::getline(in, line) || line != csv_header) return false;
+    while(std::getline(in, line)) {
+        if (line.empty()) continue;
+        const vector<string> f = split_csv_line(line);
+        if (f.size() != 10) return false;
+        CorpusResult r;
+        r.instance = f[0];
+        r.preset = f[1];
+        r.status = f[2];
+        r.wall_time = std::atof(f[3].c_str());
+        r.cpu_time = std::atof(f[4].c_str());
+        r.indep_vars = std::strtoul(f[5].c_str(), NULL, 10);
+        r.indep_groups = std::strtoul(f[6].c_str(), NULL, 10);
+        r.conflicts = std::strtoull(f[7].c_str(), NULL, 10);
+        r.mem_peak = std::strtoull(f[8].c_str(), NULL, 10);
+        timeout = std::atof(f[9].c_str());
+        results.push_back(r);
+    }
+    return true;
+}
+
+static bool write_json_db(
+    const string& fname, const vector<CorpusResult>& results, double timeout)
+{
+    std::ofstream out(fname.c_str());
+    if (!out) return false;
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n  \"timeout\": " << timeout << ",\n  \"results\": [";
+    for(size_t i = 0; i < results.size(); i++) {
+        const CorpusResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+        << "    {\"instance\": " << json_str(r.instance)
+        << ", \"preset\": " << json_str(r.preset)
+        << ", \"status\": " << json_str(r.status)
+        << ", \"wall_time\": " << r.wall_time
+        << ", \"cpu_time\": " << r.cpu_time
+        << ", \"indep_vars\": " << r.indep_vars
+        << ", \"indep_groups\": " << r.indep_groups
+        << ", \"conflicts\": " << r.conflicts
+        << ", \"mem_peak_bytes\": " << r.mem_peak
+        << "}";
+    }
+    out << "\n  ]\n}\n";
+    return (bool)out;
+}
+
+// The instances are matched by file name, so the baseline may have been run
+// from a different directory
+static string base_name(const string& path)
+{
+    const size_t at = path.find_last_of('/');
+    return at == string::npos ? path : path.substr(at+1);
+}
+
+static void compare_to_baseline(
+    const vector<CorpusResult>& results,
+    double timeout,
+    const vector<CorpusResult>& baseline,
+    double base_timeout)
+{
+    std::map<std::pair<string, string>, const CorpusResult*> base;
+    for(const auto& r: baseline) {
+        base[std::make_pair(base_name(r.instance), r.preset)] = &r;
+    }
+
+    std::set<string> presets;
+    for(const auto& r: results) presets.insert(r.preset);
+
+    cout << "c [bench] comparison against the baseline" << endl;
+    cout << "c [bench] "
+    << std::setw(12) << std::left << "preset" << std::right
+    << std::setw(7) << "inst"
+    << std::setw(9) << "solved"
+    << std::setw(9) << "base"
+    << std::setw(11) << "PAR-2"
+    << std::setw(11) << "base"
+    << std::setw(10) << "speedup"
+    << std::setw(10) << "GIS-ratio"
+    << std::setw(8) << "better"
+    << std::setw(8) << "worse"
+    << endl;
+
+    //Times below this are noise, and would dominate the geometric mean
+    const double min_time = 0.01;
+    for(const auto& preset: presets) {
+        uint32_t num = 0;
+        uint32_t solved = 0;
+        uint32_t base_solved = 0;
+        double par2 = 0;
+        double base_par2 = 0;
+        double log_speedup = 0;
+        uint32_t num_speedup = 0;
+        double log_ratio = 0;
+        uint32_t num_ratio = 0;
+        uint32_t better = 0;
+        uint32_t worse = 0;
+        for(const auto& r: results) {
+            if (r.preset != preset) continue;
+            auto it = base.find(std::make_pair(base_name(r.instance), preset));
+            if (it == base.end()) continue;
+            const CorpusResult& b = *it->second;
+            num++;
+
+            const bool ok = r.status == "ok";
+            const bool base_ok = b.status == "ok";
+            solved += ok;
+            base_solved += base_ok;
+            par2 += ok ? r.wall_time : 2*timeout;
+            base_par2 += base_ok ? b.wall_time : 2*base_timeout;
+            if (!ok || !base_ok) continue;
+
+            log_speedup += std::log(std::max(b.wall_time, min_time)/std::max(r.wall_time, min_time));
+            num_speedup++;
+            if (r.indep_groups > 0 && b.indep_groups > 0) {
+                log_ratio += std::log((double)r.indep_groups/(double)b.indep_groups);
+                num_ratio++;
+            }
+            better += r.indep_groups < b.indep_groups;
+            worse += r.indep_groups > b.indep_groups;
+        }
+        if (num == 0) {
+            cout << "c [bench] " << std::setw(12) << std::left << preset << std::right
+            << " no instances in common with the baseline" << endl;
+            continue;
+        }
+
+        cout << "c [bench] "
+        << std::setw(12) << std::left << preset << std::right
+        << std::setw(7) << num
+        << std::setw(9) << solved
+        << std::setw(9) << base_solved
+        << std::setprecision(2) << std::fixed
+        << std::setw(11) << par2/num
+        << std::setw(11) << base_par2/num
+        << std::setprecision(3)
+        << std::setw(10) << (num_speedup ? std::exp(log_speedup/num_speedup) : 1.0)
+        << std::setw(10) << (num_ratio ? std::exp(log_ratio/num_ratio) : 1.0)
+        << std::setw(8) << better
+        << std::setw(8) << worse
+        << endl;
+    }
+    cout << "c [bench] speedup is the geometric mean of baseline time / time,"
+    << " GIS-ratio the geometric mean of GIS size / baseline GIS size (in groups),"
+    << " better/worse count instances with a smaller/larger GIS" << endl;
+}
+
+int run_bench_corpus(const CorpusOptions& opts)
+{
+    #ifdef _WIN32
+    cerr << "ERROR: --bench-corpus is not supported on Windows" << endl;
+    return -1;
+    #else
+    for(const auto& p: opts.presets) {
+        Config tmp;
+        if (!apply_config_preset(p, tmp)) {
+            cerr << "ERROR! Unknown preset '" << p << "'. Known presets:" << endl;
+            for(const auto& known: config_presets()) {
+                cerr << "  " << std::setw(12) << std::left << known.name
+                << known.descr << endl;
+            }
+            return -1;
+        }
+    }
+
+    vector<CorpusResult> baseline;
+    double base_timeout = opts.timeout;
+    if (!opts.baseline_file.empty()
+        && !read_db(opts.baseline_file, baseline, base_timeout))
+    {
+        cerr << "ERROR! Could not read baseline database '"
+        << opts.baseline_file << "'" << endl;
+        return -1;
+    }
+
+    const vector<string> instances = list_instances(opts.dir);
+    if (instances.empty()) {
+        cerr << "ERROR! No instances found in directory '" << opts.dir << "'" << endl;
+        return -1;
+    }
+
+    std::ofstream db;
+    if (!opts.db_file.empty()) {
+        db.open(opts.db_file.c_str(), std::ios::out);
+        if (!db) {
+            cerr << "ERROR! Could not open file '" << opts.db_file
+            << "' for writing" << endl;
+            return -1;
+        }
+        db << csv_header << endl;
+    }
+
+    cout << "c [bench] " << instances.size() << " instances, "
+    << opts.presets.size() << " presets, timeout " << opts.timeout << " s" << endl;
+    vector<CorpusResult> results;
+    for(const auto& inst: instances) {
+        for(const auto& p: opts.presets) {
+            Config conf = opts.conf;
+            apply_config_preset(p, conf);
+            CorpusResult r = run_instance_limited(inst, conf, opts.timeout);
+            r.instance = inst;
+            r.preset = p;
+            results.push_back(r);
+
+            cout << "c [bench] "
+            << std::setw(12) << std::left << p << std::right
+            << std::setw(8) << r.status
+            << " T: " << std::setw(9) << std::setprecision(2) << std::fixed << r.wall_time
+            << " GIS: " << std::setw(7) << r.indep_groups
+            << " vars: " << std::setw(7) << r.indep_vars
+            << " " << inst << endl;
+            //Written as we go, so that a long run can be looked at midway
+            if (db.is_open()) db << csv_line(r, opts.timeout) << endl;
+        }
+    }
+
+    if (!opts.json_file.empty() && !write_json_db(opts.json_file, results, opts.timeout)) {
+        cerr << "ERROR! Could not write file '" << opts.json_file << "'" << endl;
+        return -1;
+    }
+    if (!opts.baseline_file.empty()) {
+        compare_to_baseline(results, opts.timeout, baseline, base_timeout);
+    }
+    return 0;
+    #endif
+}
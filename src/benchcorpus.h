@@ -0,0 +1,65 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_BENCHCORPUS_H
+#define ARJUN_BENCHCORPUS_H
+
+#include <string>
+#include <vector>
+#include "config.h"
+
+// Runs every instance of a directory under each of a list of named presets
+// (see presets.h), each run in its own process with a wall-clock timeout.
+// The results go to a CSV database (and optionally JSON), and if a baseline
+// database is given, to a comparison against it: solved count, PAR-2,
+// geometric mean speedup and GIS size ratio, per preset.
+struct CorpusOptions
+{
+    std::string dir;
+    std::vector<std::string> presets;
+    double timeout = 300;
+    std::string db_file;
+    std::string json_file;
+    std::string baseline_file;
+    Config conf; //the presets are applied on top of this
+};
+
+struct CorpusResult
+{
+    std::string instance;
+    std::string preset;
+    std::string status; //ok, timeout or error
+    double wall_time = 0;
+    double cpu_time = 0;
+    uint32_t indep_vars = 0;
+    uint32_t indep_groups = 0;
+    uint64_t conflicts = 0;
+    uint64_t mem_peak = 0;
+};
+
+int run_bench_corpus(const CorpusOptions& opts);
+
+#endif //ARJUN_BENCHCORPUS_H
@@ -0,0 +1,153 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "budget.h"
+#include "time_mem.h"
+
+#include <chrono>
+
+static const double optional_share = 0.5;
+static const double optional_mem_share = 0.8;
+
+void Budget::start(
+    double _time_limit,
+    uint64_t _confl_limit,
+    uint64_t _mem_limit,
+    uint64_t confl_now,
+    std::atomic<bool>* _stop,
+    std::atomic<bool>* _solver_stop)
+{
+    finish();
+    time_limit = _time_limit;
+    confl_limit = _confl_limit;
+    mem_limit = _mem_limit;
+    start_time = wallTime();
+    start_confl = confl_now;
+    stop = _stop;
+    solver_stop = _solver_stop;
+    reason.store(NULL);
+    double vm_usage;
+    last_mem.store(memUsedTotal(vm_usage));
+    in_optional = false;
+    finishing = false;
+
+    if (time_limit > 0 || mem_limit > 0) {
+        watcher = new std::thread(&Budget::watch, this);
+    }
+}
+
+void Budget::finish()
+{
+    if (watcher == NULL) return;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        finishing = true;
+    }
+    cv.notify_all();
+    watcher->join();
+    delete watcher;
+    watcher = NULL;
+}
+
+void Budget::clear()
+{
+    finish();
+    time_limit = 0;
+    confl_limit = 0;
+    mem_limit = 0;
+    reason.store(NULL);
+}
+
+void Budget::stop_now(const char* why)
+{
+    const char* expected = NULL;
+    reason.compare_exchange_strong(expected, why);
+    stop->store(true);
+    solver_stop->store(true);
+}
+
+bool Budget::optional_over() const
+{
+    if (time_limit > 0 && wallTime() - start_time >= time_limit*optional_share) return true;
+    if (mem_limit > 0 && last_mem.load() >= mem_limit*optional_mem_share) return true;
+    return false;
+}
+
+const char* Budget::optional_denied(uint64_t confl_now) const
+{
+    if (reason.load() != NULL) return reason.load();
+    if (time_limit > 0 && wallTime() - start_time >= time_limit*optional_share) {
+        return "time";
+    }
+    if (confl_limit > 0 && confl_now - start_confl >= confl_limit*optional_share) {
+        return "conflicts";
+    }
+    if (mem_limit > 0) {
+        double vm_usage;
+        if (memUsedTotal(vm_usage) >= mem_limit*optional_mem_share) return "memory";
+    }
+    return NULL;
+}
+
+void Budget::enter_optional()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    in_optional = true;
+}
+
+void Budget::leave_optional()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    in_optional = false;
+    //Unless the run as a whole was stopped, e.g. by interrupt_asap()
+    if (reason.load() == NULL && solver_stop && !(stop && stop->load())) {
+        solver_stop->store(false);
+    }
+}
+
+void Budget::watch()
+{
+    uint32_t ticks = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    while(!finishing) {
+        cv.wait_for(lock, std::chrono::milliseconds(10));
+        if (finishing) break;
+
+        //Reading the RSS means reading /proc, do it less often
+        if (mem_limit > 0 && ticks++ % 5 == 0) {
+            double vm_usage;
+            last_mem.store(memUsedTotal(vm_usage));
+        }
+        if (time_limit > 0 && wallTime() - start_time >= time_limit) {
+            stop_now("time");
+        } else if (mem_limit > 0 && last_mem.load() >= mem_limit) {
+            stop_now("memory");
+        } else if (in_optional && optional_over()) {
+            solver_stop->store(true);
+        }
+        if (reason.load() != NULL) break;
+    }
+}
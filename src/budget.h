@@ -0,0 +1,111 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_BUDGET_H
+#define ARJUN_BUDGET_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+// Limits on one get_indep_set(): wall-clock time, conflicts and resident
+// memory, each 0 if unlimited. Time and memory are watched by a thread that
+// raises the stop flags when one runs out, which makes CMS return from
+// whatever it does and the rounds keep what is undecided, so the set
+// returned is still independent. Conflicts are checked by the caller before
+// every solver call, see confl_left().
+//
+// Optional phases (simplification, guess, forward) may only start while
+// less than half of the time and conflicts and less than 80% of the memory
+// is used, and are cut short at that point, so that what remains goes to
+// backward.
+class Budget
+{
+public:
+    ~Budget() { finish(); }
+
+    void start(
+        double time_limit,
+        uint64_t confl_limit,
+        uint64_t mem_limit,
+        uint64_t confl_now,
+        std::atomic<bool>* stop,
+        std::atomic<bool>* solver_stop);
+    void finish();
+    //Finishes and forgets the limits and why we stopped
+    void clear();
+
+    bool limited() const
+    {
+        return time_limit > 0 || confl_limit > 0 || mem_limit > 0;
+    }
+
+    uint64_t confl_left(uint64_t confl_now) const
+    {
+        if (confl_limit == 0) return std::numeric_limits<uint64_t>::max();
+        const uint64_t used = confl_now - start_confl;
+        return used >= confl_limit ? 0 : confl_limit - used;
+    }
+
+    //Returns NULL if an optional phase may start, otherwise what is low
+    const char* optional_denied(uint64_t confl_now) const;
+
+    //While inside, CMS is interrupted once the share of the optional phases
+    //runs out, and let go again on leaving, unless the stop flag is set
+    void enter_optional();
+    void leave_optional();
+
+    //Sets both stop flags for good
+    void stop_now(const char* why);
+    const char* stopped_by() const { return reason.load(); }
+
+private:
+    void watch();
+    bool optional_over() const;
+
+    double time_limit = 0;
+    uint64_t confl_limit = 0;
+    uint64_t mem_limit = 0;
+    double start_time = 0;
+    uint64_t start_confl = 0;
+    std::atomic<bool>* stop = NULL;
+    std::atomic<bool>* solver_stop = NULL;
+    std::atomic<const char*> reason{NULL};
+    std::atomic<uint64_t> last_mem{0};
+
+    //Guards in_optional, so that the watcher can't interrupt CMS just after
+    //an optional phase was left
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool in_optional = false;
+    bool finishing = false;
+    std::thread* watcher = NULL;
+};
+
+#endif //ARJUN_BUDGET_H
@@ -148,6 +148,7 @@ void Common::add_fixed_clauses()
         dont_elim.push_back(Lit(var, false));
         dont_elim.push_back(Lit(var+orig_num_vars, false));
     }
+    add_acts_to_dont_elim();
     if (conf.verb) {
         cout << "c [arjun] Adding fixed clauses time: " << (cpuTime()-fix_cl_time) << endl;
     }
@@ -223,7 +224,7 @@ void Common::get_incidence()
 void Common::set_up_solver()
 {
     assert(solver == NULL);
-    solver = new SATSolver(NULL);
+    solver = new SATSolver(NULL, &solver_interrupt);
     solver->set_up_for_arjun();
     solver->set_renumber(0);
     solver->set_bve(0);
@@ -233,6 +234,76 @@ void Common::set_up_solver()
     solver->set_sls(0);
 }
 
+// Back to the state of a freshly constructed Common, with the same config,
+// callbacks and tracer. The query log is closed, its queries were about the
+// old formula. The vectors are cleared, not freed, so
+// that the next instance of a similar size doesn't allocate again. CMS can't
+// drop its clauses, so the solver is the only thing made anew
+void Common::reset()
+{
+    budget.clear();
+    interrupt_flag.store(false);
+    solver_interrupt.store(false);
+
+    if (qlog && !qlog->close()) {
+        cout << "c [arjun] WARNING: could not write all of the query log" << endl;
+    }
+    delete qlog;
+    qlog = NULL;
+
+    delete solver;
+    solver = NULL;
+    set_up_solver();
+
+    sampling_set_tmp1.clear();
+    sampling_set_tmp2.clear();
+    sampling_set = &sampling_set_tmp1;
+    other_sampling_set = &sampling_set_tmp2;
+    empty_occs.clear();
+    var2var_group.clear();
+    var_groups.clear();
+    tmp.clear();
+    seen.clear();
+    orig_num_vars = std::numeric_limits<uint32_t>::max();
+    total_eq_removed = 0;
+    total_set_removed = 0;
+    definitely_satisfiable = false;
+    var_to_indic.clear();
+    indic_to_var.clear();
+    global_assump_to_testvars.clear();
+    incidence.clear();
+    incidence_probing.clear();
+    commpart.clear();
+    commpart_incs.clear();
+
+    stats.phases.clear();
+    stats.conflicts = 0;
+    stats.mem_peak = 0;
+    stats.interrupted = false;
+    for(auto& s: oracle_stats) s = OracleStats();
+    oracle_calls = 0;
+
+    removables.clear();
+    active_acts.clear();
+    tmp_assumptions.clear();
+    duplicated = false;
+    candidates.clear();
+    prev_indep_set.clear();
+    edits.clear();
+    edits_removed = false;
+    hint.clear();
+    hint_superset = false;
+    indep_reported.clear();
+    tmp_report.clear();
+
+    vsids_scores.clear();
+    dont_elim.clear();
+    tmp_implied_by.clear();
+    toClear.clear();
+    random_source.seed(conf.seed);
+    guess_div = 10;
+}
+
 bool Common:: simplify_bve_only()
 {
     //BVE ***ONLY***, don't eliminate the orignial variables
@@ -243,17 +314,20 @@ bool Common:: simplify_bve_only()
         dont_elim.push_back(Lit(var, false));
         dont_elim.push_back(Lit(var+orig_num_vars, false));
     }
+    add_acts_to_dont_elim();
     double simpBVETime = cpuTime();
     if (conf.verb) {
         cout << "c [arjun] CMS::simplify() with *only* BVE..." << endl;
     }
 
     //Do BVE
-    if (conf.simp) {
+    if (conf.simp && start_optional("bve")) {
         solver->set_bve(1);
         solver->set_verbosity(std::max((int)conf.verb-2, 0));
         string str("occ-bve");
-        if (solver->simplify(&dont_elim, &str) == l_False) {
+        const lbool ret = solver->simplify(&dont_elim, &str);
+        end_optional();
+        if (ret == l_False) {
             return false;
         }
         if (conf.verb) {
@@ -287,17 +361,50 @@ bool Common::preproc_and_duplicate()
     seen.clear();
     seen.resize(solver->nVars(), 0);
 
-    get_incidence();
-    if (conf.simp && !simplify()) return false;
-    //incidence = solver->get_var_incidence(); //NOTE: makes it slower
-    duplicate_problem();
-    if (!simplify_bve_only()) return false;
+    //Activation variables are not to be in the set
+    if (!removables.empty()) {
+        for(const auto& r: removables) seen[r.acts[0]] = 1;
+        uint32_t j = 0;
+        for(uint32_t i = 0; i < sampling_set->size(); i++) {
+            if (!seen[(*sampling_set)[i]]) (*sampling_set)[j++] = (*sampling_set)[i];
+        }
+        sampling_set->resize(j);
+        for(const auto& r: removables) seen[r.acts[0]] = 0;
+    }
 
-    add_fixed_clauses(); //Add the connection clauses, indicator variables, etc.
-    if (!run_gauss_jordan()) return false;;
+    {
+        PhaseTimer t(this, "get_incidence");
+        get_incidence();
+    }
+    if (conf.simp) {
+        PhaseTimer t(this, "simplify");
+        if (!simplify()) return false;
+    }
+    //incidence = solver->get_var_incidence(); //NOTE: makes it slower
+    {
+        PhaseTimer t(this, "duplicate_problem");
+        duplicate_problem();
+        duplicated = true;
+        fix_up_removables();
+    }
+    {
+        PhaseTimer t(this, "simplify_bve_only");
+        if (!simplify_bve_only()) return false;
+    }
+    {
+        PhaseTimer t(this, "add_fixed_clauses");
+        add_fixed_clauses(); //Add the connection clauses, indicator variables, etc.
+    }
+    if (conf.gauss_jordan && conf.simp && start_optional("gauss_jordan")) {
+        PhaseTimer t(this, "run_gauss_jordan");
+        const bool ok = run_gauss_jordan();
+        end_optional();
+        if (!ok) return false;
+    }
 
     //Seen needs re-init, because we got new variables
     seen.clear(); seen.resize(solver->nVars(), 0);
+    candidates = *sampling_set;
 
     solver->set_simplify(conf.regularly_simplify && conf.simp);
     solver->set_intree_probe(conf.intree && conf.simp);
@@ -316,3 +423,311 @@ uint32_t Common::get_group_idx(uint32_t var)
 {
     return var2var_group[var];
 }
+
+void Common::report_indep(uint32_t var)
+{
+    if (!indep_cb) return;
+    indep_reported.resize(orig_num_vars, 0);
+    assert(var < orig_num_vars);
+    if (indep_reported[var]) return;
+
+    tmp_report.clear();
+    uint32_t group = 0;
+    if (conf.group_indep && var < var2var_group.size()) group = var2var_group[var];
+    if (group != 0) {
+        for(const auto& grp_var: var_groups[group]) {
+            indep_reported[grp_var] = 1;
+            tmp_report.push_back(grp_var);
+        }
+    } else {
+        indep_reported[var] = 1;
+        tmp_report.push_back(var);
+    }
+    indep_cb(group, tmp_report, false);
+}
+
+void Common::report_indep_done(const vector<uint32_t>& final_set)
+{
+    if (!indep_cb) return;
+    indep_cb(0, final_set, true);
+}
+
+// bound() fills in the set the phase would leave if it stopped now. The
+// empty occurrence variables were taken out of the sampling set, but they
+// are in the result, so they are added here
+bool Common::report_progress(
+    const char* phase,
+    uint64_t decided,
+    uint64_t remaining,
+    const std::function<void(vector<uint32_t>&)>& bound)
+{
+    if (!progress_cb) return true;
+
+    ArjunNS::Progress p;
+    p.phase = phase;
+    p.decided = decided;
+    p.remaining = remaining;
+    p.upper_bound = [&]() {
+        vector<uint32_t> ret(empty_occs);
+        bound(ret);
+        return ret;
+    };
+    if (progress_cb(p)) return true;
+
+    verb_print(1, "[arjun] stopped by the progress callback in " << phase);
+    interrupt_flag.store(true);
+    return false;
+}
+
+PhaseTimer::PhaseTimer(Common* _comm, const char* _name) :
+    comm(_comm),
+    name(_name)
+{
+    ArjunNS::PhaseStat ps;
+    ps.name = name;
+    at = comm->stats.phases.size();
+    comm->stats.phases.push_back(ps);
+
+    double vm_usage;
+    start_rss = memUsedTotal(vm_usage);
+    start_max_rss = memPeakTotal();
+    start_confl = comm->solver->get_sum_conflicts();
+    start_props = comm->solver->get_sum_propagations();
+    start_cpu = cpuTime();
+    start_wall = wallTime();
+    if (comm->tracer) start_trace = comm->tracer->now();
+    if (comm->get_perf()) start_hw = comm->perf->read();
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    ArjunNS::PhaseStat& ps = stat();
+    ps.wall_time = wallTime() - start_wall;
+    ps.cpu_time = cpuTime() - start_cpu;
+    if (comm->get_perf()) {
+        const PerfCounters::Values hw = comm->perf->read();
+        uint64_t* out[PerfCounters::num_counters] = {
+            &ps.cycles, &ps.instructions, &ps.llc_misses, &ps.branch_misses};
+        for(uint32_t i = 0; i < PerfCounters::num_counters; i++) {
+            if (!hw.valid[i] || !start_hw.valid[i]) continue;
+            *out[i] = hw.v[i] - start_hw.v[i];
+            ps.hw_counters = true;
+        }
+    }
+
+    //the solver may have been swapped out in the meanwhile, see forward_round
+    const uint64_t confl = comm->solver->get_sum_conflicts();
+    const uint64_t props = comm->solver->get_sum_propagations();
+    ps.conflicts = (confl >= start_confl) ? (confl - start_confl) : confl;
+    ps.propagations = (props >= start_props) ? (props - start_props) : props;
+
+    double vm_usage;
+    const uint64_t rss = memUsedTotal(vm_usage);
+    const uint64_t max_rss = memPeakTotal();
+    ps.rss_delta = (int64_t)rss - (int64_t)start_rss;
+    ps.rss_peak = std::max(start_rss, rss);
+    //The high-water mark of the process only moves if this phase pushed it
+    if (max_rss > start_max_rss) ps.rss_peak = std::max(ps.rss_peak, max_rss);
+    comm->stats.mem_peak = std::max(comm->stats.mem_peak, ps.rss_peak);
+    if (comm->tracer) comm->tracer->span(name, "phase", start_trace);
+}
+
+ArjunNS::PhaseStat& PhaseTimer::stat()
+{
+    return comm->stats.phases[at];
+}
+
+void Common::print_phase_stats() const
+{
+    cout << "c [arjun-prof] "
+    << std::setw(18) << std::left << "phase" << std::right
+    << std::setw(10) << "wall"
+    << std::setw(10) << "cpu"
+    << std::setw(11) << "rss-delta"
+    << std::setw(10) << "rss-peak"
+    << std::setw(8) << "confl"
+    << std::setw(8) << "props"
+    << endl;
+    for(const auto& ps: stats.phases) {
+        cout << "c [arjun-prof] "
+        << std::setw(18) << std::left << ps.name << std::right
+        << std::setprecision(2) << std::fixed
+        << std::setw(10) << ps.wall_time
+        << std::setw(10) << ps.cpu_time
+        << std::setw(9) << ps.rss_delta/(1024*1024) << "MB"
+        << std::setw(8) << ps.rss_peak/(1024*1024) << "MB"
+        << std::setw(8) << print_value_kilo_mega(ps.conflicts, false)
+        << std::setw(8) << print_value_kilo_mega(ps.propagations, false)
+        << endl;
+    }
+    cout << "c [arjun-prof] peak RSS: " << stats.mem_peak/(1024*1024) << " MB" << endl;
+
+    bool have_hw = false;
+    for(const auto& ps: stats.phases) have_hw |= ps.hw_counters;
+    if (!have_hw) return;
+    cout << "c [arjun-perf] "
+    << std::setw(18) << std::left << "phase" << std::right
+    << std::setw(9) << "cycles"
+    << std::setw(9) << "instr"
+    << std::setw(7) << "IPC"
+    << std::setw(9) << "LLC-miss"
+    << std::setw(10) << "LLC/kinst"
+    << std::setw(9) << "br-miss"
+    << std::setw(10) << "br/kinst"
+    << endl;
+    for(const auto& ps: stats.phases) {
+        if (!ps.hw_counters) continue;
+        const double kinstr = (double)ps.instructions/1000.0;
+        cout << "c [arjun-perf] "
+        << std::setw(18) << std::left << ps.name << std::right
+        << std::setw(9) << print_value_kilo_mega(ps.cycles, false)
+        << std::setw(9) << print_value_kilo_mega(ps.instructions, false)
+        << std::setprecision(2) << std::fixed
+        << std::setw(7) << (ps.cycles ? (double)ps.instructions/(double)ps.cycles : 0.0)
+        << std::setw(9) << print_value_kilo_mega(ps.llc_misses, false)
+        << std::setw(10) << (kinstr > 0 ? (double)ps.llc_misses/kinstr : 0.0)
+        << std::setw(9) << print_value_kilo_mega(ps.branch_misses, false)
+        << std::setw(10) << (kinstr > 0 ? (double)ps.branch_misses/kinstr : 0.0)
+        << endl;
+    }
+}
+
+PerfCounters* Common::get_perf()
+{
+    if (!conf.perf_counters) return NULL;
+    if (perf == NULL) {
+        perf = new PerfCounters;
+        if (!perf->available() && conf.verb) {
+            cout << "c [arjun-perf] hardware counters are not available ("
+            << perf->why_not() << "), continuing without them" << endl;
+        }
+    }
+    return perf->available() ? perf : NULL;
+}
+
+bool Common::start_optional(const char* phase)
+{
+    if (interrupted()) return false;
+    if (!budget.limited()) return true;
+
+    const char* low = budget.optional_denied(solver->get_sum_conflicts());
+    if (low) {
+        verb_print(1, "[arjun-budget] skipping " << phase << ", low on " << low);
+        return false;
+    }
+    budget.enter_optional();
+    return true;
+}
+
+void Common::end_optional()
+{
+    if (budget.limited()) budget.leave_optional();
+}
+
+// Caps the conflicts of a solver call to what's left of the budget, and
+// stops everything once nothing is left
+uint64_t Common::budget_confl(uint64_t max_confl)
+{
+    if (!budget.limited()) return max_confl;
+    const uint64_t left = budget.confl_left(solver->get_sum_conflicts());
+    if (left == 0) budget.stop_now("conflicts");
+    return std::min(max_confl, left);
+}
+
+lbool Common::oracle_solve(
+    const vector<Lit>& assumptions, uint64_t max_confl, OracleCaller caller)
+{
+    max_confl = budget_confl(max_confl);
+    if (interrupted()) return l_Undef;
+    const double start_time = wallTime();
+    const bool traced = tracer && (oracle_calls++ % conf.trace_solve_every) == 0;
+    const uint64_t start_trace = traced ? tracer->now() : 0;
+    const uint64_t start_confl = solver->get_sum_conflicts();
+    const uint64_t start_props = solver->get_sum_propagations();
+
+    solver->set_max_confl(max_confl);
+    const lbool ret = solver->solve(&with_active_acts(assumptions));
+
+    const double us = (wallTime()-start_time)*1e6;
+    const uint64_t time_us = us < 0 ? 0 : (uint64_t)us;
+    const uint64_t confl = solver->get_sum_conflicts() - start_confl;
+    const uint64_t props = solver->get_sum_propagations() - start_props;
+    oracle_stats[caller].add(ret, time_us, confl, props, assumptions.size());
+    if (qlog) {
+        log_query(caller, assumptions, OracleStats::outcome_idx(ret),
+            max_confl, confl, props, time_us, 0);
+    }
+    if (traced) {
+        const char* name = "solve U";
+        if (ret == l_True) name = "solve T";
+        else if (ret == l_False) name = "solve F";
+        tracer->span(name, "oracle", start_trace, assumptions.size());
+    }
+    return ret;
+}
+
+bool Common::oracle_implied_by(
+    const vector<Lit>& assumptions, vector<Lit>& implied, uint64_t max_confl)
+{
+    max_confl = budget_confl(max_confl);
+    if (interrupted()) return false;
+    const double start_time = wallTime();
+    const uint64_t start_confl = solver->get_sum_conflicts();
+    const uint64_t start_props = solver->get_sum_propagations();
+
+    solver->set_max_confl(max_confl);
+    const bool ok = solver->implied_by(with_active_acts(assumptions), implied);
+
+    const double us = (wallTime()-start_time)*1e6;
+    const uint64_t time_us = us < 0 ? 0 : (uint64_t)us;
+    const uint64_t confl = solver->get_sum_conflicts() - start_confl;
+    const uint64_t props = solver->get_sum_propagations() - start_props;
+    //TRUE: the assumptions are consistent, FALSE: they are not
+    const lbool ret = ok ? l_True : l_False;
+    oracle_stats[oracle_guess].add(ret, time_us, confl, props, assumptions.size());
+    if (qlog) {
+        log_query(oracle_guess, assumptions, OracleStats::outcome_idx(ret),
+            max_confl, confl, props, time_us, ok ? implied.size() : 0);
+    }
+    return ok;
+}
+
+void Common::log_query(
+    OracleCaller caller,
+    const vector<Lit>& assumptions,
+    uint32_t outcome,
+    uint64_t max_confl,
+    uint64_t conflicts,
+    uint64_t props,
+    uint64_t time_us,
+    uint64_t implied)
+{
+    OracleQuery& q = tmp_query;
+    q.caller = caller;
+    q.outcome = outcome;
+    q.max_confl = max_confl;
+    q.conflicts = conflicts;
+    q.props = props;
+    q.time_us = time_us;
+    q.implied = implied;
+    q.lits.clear();
+    for(const Lit l: assumptions) {
+        const uint32_t v = l.var();
+        if (v < indic_to_var.size() && indic_to_var[v] != var_Undef) {
+            q.lits.push_back(OracleQuery::encode(indic_to_var[v], true, l.sign()));
+        } else {
+            q.lits.push_back(OracleQuery::encode(v, false, l.sign()));
+        }
+    }
+    qlog->write(q);
+}
+
+void Common::print_oracle_stats() const
+{
+    if (oracle_stats[oracle_guess].calls() > 0)
+        oracle_stats[oracle_guess].print("guess");
+    if (oracle_stats[oracle_forward].calls() > 0)
+        oracle_stats[oracle_forward].print("forward");
+    if (oracle_stats[oracle_backward].calls() > 0)
+        oracle_stats[oracle_backward].print("backward");
+}
@@ -41,11 +41,20 @@
 #include <vector>
 #include <sstream>
 #include <string>
+#include <functional>
+#include <atomic>
 #include <cryptominisat5/cryptominisat.h>
 #include "cryptominisat5/dimacsparser.h"
 
 #include "time_mem.h"
 #include "config.h"
+#include "arjun.h"
+#include "oraclestats.h"
+#include "trace.h"
+#include "perfcounters.h"
+#include "querylog.h"
+#include "asynclog.h"
+#include "budget.h"
 
 using namespace CMSat;
 using std::cout;
@@ -67,6 +76,9 @@ struct Common
     ~Common()
     {
         delete solver;
+        delete tracer;
+        delete perf;
+        delete qlog;
     }
 
     Config conf;
@@ -113,6 +125,108 @@ struct Common
     //total incidence in a commpart. Maps commpart->maxinc
     vector<uint32_t> commpart_incs;
 
+    //Per-phase statistics, see PhaseTimer
+    ArjunNS::RunStats stats;
+    void print_phase_stats() const;
+    void compute_features(ArjunNS::InstanceFeatures& f);
+
+    //Hardware counters for PhaseTimer, opened on first use if conf.perf_counters
+    PerfCounters* perf = NULL;
+    PerfCounters* get_perf();
+
+    //Every oracle query of guess/forward/backward goes through here, so its
+    //latency and cost can be accounted for per outcome, and it can be logged
+    enum OracleCaller {oracle_forward = 0, oracle_backward = 1, oracle_guess = 2};
+    OracleStats oracle_stats[3];
+    lbool oracle_solve(
+        const vector<Lit>& assumptions, uint64_t max_confl, OracleCaller caller);
+    bool oracle_implied_by(
+        const vector<Lit>& assumptions, vector<Lit>& implied, uint64_t max_confl);
+    void print_oracle_stats() const;
+
+    //Query log, see querylog.h. NULL unless recording
+    QueryLogWriter* qlog = NULL;
+    OracleQuery tmp_query;
+    void log_query(
+        OracleCaller caller,
+        const vector<Lit>& assumptions,
+        uint32_t outcome,
+        uint64_t max_confl,
+        uint64_t conflicts,
+        uint64_t props,
+        uint64_t time_us,
+        uint64_t implied);
+    bool replay_queries(const string& fname, int64_t max_confl);
+
+    //Timeline of the run, NULL unless tracing was asked for
+    Tracer* tracer = NULL;
+    uint64_t oracle_calls = 0;
+
+    //Set from another thread by Arjun::interrupt_asap(). The oracle then
+    //answers Undef without solving, and the rounds stop at the next item,
+    //keeping whatever is undecided
+    std::atomic<bool> interrupt_flag{false};
+    bool interrupted() const { return interrupt_flag.load(std::memory_order_relaxed); }
+    //Given to CMS, which checks it in solve() and simplify()
+    std::atomic<bool> solver_interrupt{false};
+
+    //Time, conflict and memory limits of get_indep_set(). Optional phases
+    //are run between start_optional() and end_optional(), and are skipped
+    //if start_optional() returns FALSE
+    Budget budget;
+    bool start_optional(const char* phase);
+    void end_optional();
+    uint64_t budget_confl(uint64_t max_confl);
+
+    //Incremental use, see incremental.cpp
+    struct Removable {
+        vector<Lit> lits;
+        vector<uint32_t> acts; //activation variables, assumed FALSE while active
+        bool active = true;
+        bool removed = false;
+    };
+    vector<Removable> removables;
+    vector<Lit> active_acts;
+    vector<Lit> tmp_assumptions;
+    bool duplicated = false;
+    vector<uint32_t> candidates; //sampling set once simplified
+    vector<uint32_t> prev_indep_set; //result of the last run, without empty occs
+    vector<vector<uint32_t>> edits; //variables of the clauses edited since
+    bool edits_removed = false;
+    uint32_t add_removable_clause(const vector<Lit>& lits, bool active);
+    bool set_clause_active(uint32_t id, bool active);
+    bool remove_clause(uint32_t id);
+    void add_acts_to_dont_elim();
+    bool add_clause_for_good(const vector<Lit>& lits);
+    void note_edit(const vector<Lit>& lits, bool removed);
+    void update_active_acts();
+    void fix_up_removables();
+    const vector<Lit>& with_active_acts(const vector<Lit>& assumptions);
+    void mark_affected(vector<char>& affected);
+    void redo_after_edits();
+
+    //Candidate set given by the user, see Arjun::set_hint_indep_set()
+    vector<uint32_t> hint;
+    bool hint_superset = false;
+    void mark_hinted(vector<char>& hinted) const;
+    void order_by_hint(vector<uint32_t>& unknown) const;
+    void restrict_to_hint();
+
+    //Streaming of the independent set as it gets decided
+    std::function<void(uint32_t, const vector<uint32_t>&, bool)> indep_cb;
+    vector<char> indep_reported;
+    vector<uint32_t> tmp_report;
+    void report_indep(uint32_t var);
+    void report_indep_done(const vector<uint32_t>& final_set);
+
+    //Progress of the search, see Arjun::set_progress_callback()
+    std::function<bool(const ArjunNS::Progress&)> progress_cb;
+    bool report_progress(
+        const char* phase,
+        uint64_t decided,
+        uint64_t remaining,
+        const std::function<void(vector<uint32_t>&)>& bound);
+
     vector<double> vsids_scores;
     vector<Lit> dont_elim;
     vector<Lit> tmp_implied_by;
@@ -123,6 +237,7 @@ struct Common
         const vector<uint32_t>& indep
     );
     bool preproc_and_duplicate();
+    void reset();
     void add_fixed_clauses();
     void print_orig_sampling_set();
     void start_with_clean_sampling_set();
@@ -199,7 +314,7 @@ struct Common
         vector<uint32_t>& unknown,
         const vector<char>& unknown_set,
         const vector<uint32_t>& indep);
-    void backward_round();
+    void backward_round(const vector<uint32_t>& known_indep = vector<uint32_t>());
 
     //Sorting
     template<class T> void sort_unknown(T& unknown);
@@ -207,6 +322,30 @@ struct Common
 };
 
 
+// Profiles one phase of the run, from construction to destruction: wall and
+// CPU time, change and high-water mark of the RSS, and the conflicts and
+// propagations the solver used. The result goes to Common::stats.phases.
+class PhaseTimer
+{
+public:
+    PhaseTimer(Common* comm, const char* name);
+    ~PhaseTimer();
+    ArjunNS::PhaseStat& stat();
+
+private:
+    Common* comm;
+    const char* name;
+    size_t at;
+    uint64_t start_trace = 0;
+    double start_wall;
+    double start_cpu;
+    uint64_t start_confl;
+    uint64_t start_props;
+    uint64_t start_rss;
+    uint64_t start_max_rss;
+    PerfCounters::Values start_hw;
+};
+
 inline string print_value_kilo_mega(const int64_t value, bool setw = true)
 {
     std::stringstream ss;
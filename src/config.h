@@ -57,6 +57,13 @@ struct Config {
     unsigned long backbone_simpl_max_confl = 10ULL*1000ULL;
     uint32_t backw_max_confl = 500;
     uint32_t guess_max_confl = 1000;
+    uint32_t trace_solve_every = 16;
+    int perf_counters = 0;
+    double heartbeat = 60; //seconds between progress lines of backward, 0 is off
+    //Budget of get_indep_set(), 0 is unlimited. See budget.h
+    double time_limit = 0; //seconds, wall clock
+    uint64_t confl_budget_total = 0;
+    uint64_t mem_limit = 0; //bytes, resident
 };
 
 //ARJUN_CONFIG_H
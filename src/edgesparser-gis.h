@@ -0,0 +1,409 @@
+/******************************************
+Copyright (C) 2023 Anna L.D. Latour, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#pragma once
+
+#include "streambuffer.h"
+#include <cryptominisat5/solvertypesmini.h>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cassert>
+
+using std::vector;
+using std::cout;
+using std::endl;
+
+namespace EdgesParserGIS {
+
+/** Reads an undirected graph as an edge list (one "u v" pair per line, lines
+ * starting with '#', '%' or 'c' are comments), and builds the identifying
+ * code encoding of the paper straight into the solver:
+ *
+ *  - variable x_v (index v) for every node v,
+ *  - variable y_v (index n+v) with y_v <-> OR_{u in N[v]} x_u,
+ *  - at most k of the x_v are TRUE,
+ *  - group {x_v, y_v} for every node v, all x_v and y_v in the sampling set.
+ *
+ * Node labels are renumbered to 0..n-1 in ascending order, so x_v
+ * corresponds to the v-th smallest label.
+ *
+ * build_sweep() encodes every k of a range at once instead, each "at most k"
+ * constraint in a removable clause of its own, see k_clauses. */
+template <class C, class S>
+class EdgesParser
+{
+    public:
+        EdgesParser(S* solver, unsigned _verbosity);
+
+        template <class T> bool parse_edges(T input_stream);
+        void add_edge(uint64_t u, uint64_t v);
+
+        /** Adds the encoding for the graph read so far. If use_bnn is set,
+         * the cardinality constraint is added as a single BNN constraint,
+         * otherwise as a sequential counter CNF with auxiliary variables. */
+        void build(uint32_t k, bool use_bnn);
+
+        /** Same for every k in k_min..k_max, with the "at most k" constraints
+         * added through add_removable_clause(), only the one of k_max
+         * active. k_clauses[k-k_min] is the id of the clause, or UINT32_MAX
+         * if k is not below the number of nodes, so there is nothing to
+         * constrain. Lowering k only adds a constraint, so going from k_max
+         * down, each set is a superset of the next. */
+        void build_sweep(uint32_t k_min, uint32_t k_max, bool use_bnn);
+        vector<uint32_t> k_clauses;
+
+        vector<uint32_t> sampling_vars;
+        vector<uint32_t> var2var_group;
+        vector<vector<uint32_t>> var_groups;
+        vector<uint64_t> node_labels;
+        uint32_t num_nodes = 0;
+        uint64_t num_edges = 0;
+
+    private:
+        void renumber();
+        void add_neighbourhoods();
+        void set_groups();
+        void print_stats(const char* k_str, bool use_bnn);
+        void add_at_most_k_cnf(uint32_t k);
+        uint32_t add_counter_cnf(uint32_t k_max);
+
+        S* solver;
+        unsigned verbosity;
+        size_t lineNum = 0;
+
+        vector<std::pair<uint64_t, uint64_t>> edges;
+        vector<vector<uint32_t>> neighs;
+        vector<CMSat::Lit> lits;
+};
+
+template<class C, class S>
+EdgesParser<C, S>::EdgesParser(S* _solver, unsigned _verbosity) :
+    solver(_solver)
+    , verbosity(_verbosity)
+{
+}
+
+template<class C, class S>
+void EdgesParser<C, S>::add_edge(uint64_t u, uint64_t v)
+{
+    edges.push_back(std::make_pair(u, v));
+}
+
+template <class C, class S>
+template <class T>
+bool EdgesParser<C, S>::parse_edges(T input_stream)
+{
+    C in(input_stream);
+    for (;;) {
+        in.skipWhitespace();
+        switch (*in) {
+        case EOF:
+            return true;
+        case '#':
+        case '%':
+        case 'c':
+        case '\n':
+            in.skipLine();
+            lineNum++;
+            break;
+        default: {
+            int64_t u, v;
+            if (!in.template parseInt<int64_t>(u, lineNum)
+                || !in.template parseInt<int64_t>(v, lineNum))
+            {
+                return false;
+            }
+            if (u < 0 || v < 0) {
+                std::cerr << "ERROR! Negative node label at line " << lineNum+1 << endl;
+                return false;
+            }
+            add_edge(u, v);
+
+            // Anything after the two endpoints (e.g. a weight) is ignored
+            in.skipLine();
+            lineNum++;
+            break;
+        }
+        }
+    }
+}
+
+template<class C, class S>
+void EdgesParser<C, S>::renumber()
+{
+    node_labels.clear();
+    for(const auto& e: edges) {
+        node_labels.push_back(e.first);
+        node_labels.push_back(e.second);
+    }
+    std::sort(node_labels.begin(), node_labels.end());
+    node_labels.erase(std::unique(node_labels.begin(), node_labels.end()), node_labels.end());
+    num_nodes = node_labels.size();
+
+    // Closed neighbourhoods, N[v]
+    neighs.clear();
+    neighs.resize(num_nodes);
+    for(uint32_t v = 0; v < num_nodes; v++) neighs[v].push_back(v);
+    num_edges = 0;
+    for(const auto& e: edges) {
+        uint32_t u = std::lower_bound(node_labels.begin(), node_labels.end(), e.first) - node_labels.begin();
+        uint32_t v = std::lower_bound(node_labels.begin(), node_labels.end(), e.second) - node_labels.begin();
+        if (u == v) continue;
+        neighs[u].push_back(v);
+        neighs[v].push_back(u);
+        num_edges++;
+    }
+    for(auto& n: neighs) {
+        std::sort(n.begin(), n.end());
+        n.erase(std::unique(n.begin(), n.end()), n.end());
+    }
+    edges.clear();
+    edges.shrink_to_fit();
+}
+
+template<class C, class S>
+void EdgesParser<C, S>::add_neighbourhoods()
+{
+    const uint32_t n = num_nodes;
+    const uint32_t start = solver->nVars();
+    assert(start == 0 && "The encoding must be the only thing in the solver");
+    solver->new_vars(2*n);
+
+    // y_v <-> OR_{u in N[v]} x_u
+    for(uint32_t v = 0; v < n; v++) {
+        const CMSat::Lit y(n+v, false);
+        lits.clear();
+        lits.push_back(~y);
+        for(const uint32_t u: neighs[v]) lits.push_back(CMSat::Lit(u, false));
+        solver->add_clause(lits);
+
+        for(const uint32_t u: neighs[v]) {
+            lits.clear();
+            lits.push_back(y);
+            lits.push_back(CMSat::Lit(u, true));
+            solver->add_clause(lits);
+        }
+    }
+    neighs.clear();
+    neighs.shrink_to_fit();
+}
+
+template<class C, class S>
+void EdgesParser<C, S>::set_groups()
+{
+    const uint32_t n = num_nodes;
+    sampling_vars.clear();
+    var2var_group.clear();
+    var2var_group.resize(solver->nVars(), 0);
+    var_groups.clear();
+    var_groups.resize(n+1);
+    for(uint32_t v = 0; v < n; v++) {
+        sampling_vars.push_back(v);
+        sampling_vars.push_back(n+v);
+        var2var_group[v] = v+1;
+        var2var_group[n+v] = v+1;
+        var_groups[v+1].push_back(v);
+        var_groups[v+1].push_back(n+v);
+    }
+}
+
+template<class C, class S>
+void EdgesParser<C, S>::print_stats(const char* k_str, bool use_bnn)
+{
+    if (verbosity) {
+        cout
+        << "c -- nodes: " << num_nodes << endl
+        << "c -- edges: " << num_edges << endl
+        << "c -- k: " << k_str << (use_bnn ? " (BNN)" : " (CNF)") << endl
+        << "c -- vars added " << solver->nVars() << endl;
+    }
+}
+
+template<class C, class S>
+void EdgesParser<C, S>::build(uint32_t k, bool use_bnn)
+{
+    renumber();
+    add_neighbourhoods();
+    const uint32_t n = num_nodes;
+
+    // At most k of the x_v are TRUE, i.e. at least n-k of them are FALSE
+    if (k < n) {
+        if (use_bnn) {
+            lits.clear();
+            for(uint32_t v = 0; v < n; v++) lits.push_back(CMSat::Lit(v, true));
+            solver->add_bnn_clause(lits, n-k);
+        } else {
+            add_at_most_k_cnf(k);
+        }
+    }
+
+    set_groups();
+    print_stats(std::to_string(k).c_str(), use_bnn);
+}
+
+// The constraint of k is a unit clause on a variable that is TRUE iff more
+// than k of the x_v are: the output of a BNN per k, or one column of a
+// single sequential counter
+template<class C, class S>
+void EdgesParser<C, S>::build_sweep(uint32_t k_min, uint32_t k_max, bool use_bnn)
+{
+    assert(k_min <= k_max);
+    renumber();
+    add_neighbourhoods();
+    const uint32_t n = num_nodes;
+
+    k_clauses.clear();
+    const uint32_t k_top = std::min(k_max, n == 0 ? 0 : n-1);
+    uint32_t s_start = 0;
+    if (!use_bnn && k_min < n) s_start = add_counter_cnf(k_top);
+    for(uint32_t k = k_min; k <= k_max; k++) {
+        if (k >= n) {
+            k_clauses.push_back(std::numeric_limits<uint32_t>::max());
+            continue;
+        }
+        CMSat::Lit more_than_k;
+        if (use_bnn) {
+            solver->new_var();
+            const CMSat::Lit at_most_k(solver->nVars()-1, false);
+            lits.clear();
+            for(uint32_t v = 0; v < n; v++) lits.push_back(CMSat::Lit(v, true));
+            solver->add_bnn_clause(lits, n-k, at_most_k);
+            more_than_k = ~at_most_k;
+        } else {
+            more_than_k = CMSat::Lit(s_start + (n-1)*(k_top+1) + k, false);
+        }
+        lits.clear();
+        lits.push_back(~more_than_k);
+        k_clauses.push_back(solver->add_removable_clause(lits, k == k_max));
+    }
+
+    set_groups();
+    const std::string k_str = std::to_string(k_min) + ".." + std::to_string(k_max);
+    print_stats(k_str.c_str(), use_bnn);
+}
+
+// Sequential counter without a bound: s(i, j) is TRUE if at least j+1 of
+// x_0..x_i are, for j = 0..k_max. Only the direction needed to bound the
+// count from above is encoded. Returns the index of s(0, 0)
+template<class C, class S>
+uint32_t EdgesParser<C, S>::add_counter_cnf(uint32_t k_max)
+{
+    const uint32_t n = num_nodes;
+    const uint32_t cols = k_max+1;
+    auto x = [](uint32_t i) { return CMSat::Lit(i, false); };
+    const uint32_t s_start = solver->nVars();
+    solver->new_vars(n*cols);
+    auto s = [&](uint32_t i, uint32_t j) { return CMSat::Lit(s_start + i*cols + j, false); };
+
+    for(uint32_t i = 0; i < n; i++) {
+        lits.clear();
+        lits.push_back(~x(i));
+        lits.push_back(s(i, 0));
+        solver->add_clause(lits);
+        if (i == 0) continue;
+
+        for(uint32_t j = 0; j < cols; j++) {
+            lits.clear();
+            lits.push_back(~s(i-1, j));
+            lits.push_back(s(i, j));
+            solver->add_clause(lits);
+
+            if (j == 0) continue;
+            lits.clear();
+            lits.push_back(~x(i));
+            lits.push_back(~s(i-1, j-1));
+            lits.push_back(s(i, j));
+            solver->add_clause(lits);
+        }
+    }
+    return s_start;
+}
+
+// Sinz' sequential counter: s(i, j) means at least j+1 of x_0..x_i are TRUE
+template<class C, class S>
+void EdgesParser<C, S>::add_at_most_k_cnf(uint32_t k)
+{
+    const uint32_t n = num_nodes;
+    auto x = [](uint32_t i) { return CMSat::Lit(i, false); };
+    if (k == 0) {
+        for(uint32_t i = 0; i < n; i++) {
+            lits.clear();
+            lits.push_back(~x(i));
+            solver->add_clause(lits);
+        }
+        return;
+    }
+
+    const uint32_t s_start = solver->nVars();
+    solver->new_vars((n-1)*k);
+    auto s = [&](uint32_t i, uint32_t j) { return CMSat::Lit(s_start + i*k + j, false); };
+
+    lits.clear();
+    lits.push_back(~x(0));
+    lits.push_back(s(0, 0));
+    solver->add_clause(lits);
+    for(uint32_t j = 1; j < k; j++) {
+        lits.clear();
+        lits.push_back(~s(0, j));
+        solver->add_clause(lits);
+    }
+
+    for(uint32_t i = 1; i < n-1; i++) {
+        lits.clear();
+        lits.push_back(~x(i));
+        lits.push_back(s(i, 0));
+        solver->add_clause(lits);
+
+        lits.clear();
+        lits.push_back(~s(i-1, 0));
+        lits.push_back(s(i, 0));
+        solver->add_clause(lits);
+
+        for(uint32_t j = 1; j < k; j++) {
+            lits.clear();
+            lits.push_back(~x(i));
+            lits.push_back(~s(i-1, j-1));
+            lits.push_back(s(i, j));
+            solver->add_clause(lits);
+
+            lits.clear();
+            lits.push_back(~s(i-1, j));
+            lits.push_back(s(i, j));
+            solver->add_clause(lits);
+        }
+
+        lits.clear();
+        lits.push_back(~x(i));
+        lits.push_back(~s(i-1, k-1));
+        solver->add_clause(lits);
+    }
+
+    lits.clear();
+    lits.push_back(~x(n-1));
+    lits.push_back(~s(n-2, k-1));
+    solver->add_clause(lits);
+}
+
+}
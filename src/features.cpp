@@ -0,0 +1,148 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "common.h"
+#include <cmath>
+
+// Cheap, syntactic features of the formula as given, before anything is run
+// on it, for picking a configuration. Linear in its size, apart from the
+// XOR and gate detection, which only look at short clauses and at
+// literals with enough binary clauses to be the output of a gate.
+void Common::compute_features(ArjunNS::InstanceFeatures& f)
+{
+    f = ArjunNS::InstanceFeatures();
+    const uint32_t nvars = solver->nVars();
+    f.num_vars = nvars;
+    f.sampling_set_size = sampling_set->size();
+
+    vector<Lit> cnf = get_cnf();
+    vector<uint32_t> degree(nvars, 0);
+    vector<uint32_t> bin_count(2*nvars, 0);
+    set<std::pair<uint32_t, uint32_t>> bins;
+    map<vector<uint32_t>, vector<uint32_t>> xor_cands;
+    vector<vector<Lit>> long_cls;
+
+    vector<Lit> cl;
+    for(const Lit l: cnf) {
+        if (l != lit_Undef) {
+            cl.push_back(l);
+            continue;
+        }
+        f.num_clauses++;
+        f.num_lits += cl.size();
+        for(const Lit l2: cl) degree[l2.var()]++;
+        if (cl.size() == 2) {
+            f.num_bin_clauses++;
+            bin_count[cl[0].toInt()]++;
+            bin_count[cl[1].toInt()]++;
+            bins.insert(std::make_pair(
+                std::min(cl[0].toInt(), cl[1].toInt()),
+                std::max(cl[0].toInt(), cl[1].toInt())));
+        }
+        if (cl.size() >= 3 && cl.size() <= 64) long_cls.push_back(cl);
+
+        //XOR candidates: the variables, and which of them are negated
+        if (cl.size() >= 2 && cl.size() <= 5) {
+            std::sort(cl.begin(), cl.end());
+            vector<uint32_t> vars;
+            uint32_t mask = 0;
+            for(uint32_t i = 0; i < cl.size(); i++) {
+                vars.push_back(cl[i].var());
+                if (cl[i].sign()) mask |= 1U << i;
+            }
+            if (std::adjacent_find(vars.begin(), vars.end()) == vars.end()) {
+                xor_cands[vars].push_back(mask);
+            }
+        }
+        cl.clear();
+    }
+
+    //An XOR over k variables is the 2^(k-1) clauses of one parity
+    for(auto& x: xor_cands) {
+        auto& masks = x.second;
+        std::sort(masks.begin(), masks.end());
+        masks.erase(std::unique(masks.begin(), masks.end()), masks.end());
+        const uint32_t need = 1U << (x.first.size()-1);
+        uint32_t parity[2] = {0, 0};
+        for(auto m: masks) {
+            uint32_t odd = 0;
+            for(; m != 0; m >>= 1) odd ^= m & 1;
+            parity[odd]++;
+        }
+        if (parity[0] == need || parity[1] == need) f.num_xors++;
+    }
+
+    //y = OR(x_1..x_k): (-y V x_1 V .. V x_k) and (y V -x_i) for every i
+    for(const auto& c: long_cls) {
+        for(const Lit a: c) {
+            if (bin_count[(~a).toInt()] < c.size()-1) continue;
+            bool all = true;
+            for(const Lit b: c) {
+                if (b == a) continue;
+                const uint32_t l1 = (~a).toInt();
+                const uint32_t l2 = (~b).toInt();
+                if (!bins.count(std::make_pair(std::min(l1, l2), std::max(l1, l2)))) {
+                    all = false;
+                    break;
+                }
+            }
+            if (all) {
+                f.num_or_gates++;
+                break;
+            }
+        }
+    }
+
+    for (const BNN* bnn: solver->get_bnns()) {
+        if (bnn == NULL) continue;
+        f.num_bnns++;
+        for (const auto& l: *bnn) degree[l.var()]++;
+    }
+
+    if (nvars > 0) {
+        double sum = 0;
+        for(const auto d: degree) {
+            sum += d;
+            f.max_var_degree = std::max(f.max_var_degree, d);
+        }
+        f.avg_var_degree = sum/nvars;
+        double var = 0;
+        for(const auto d: degree) var += (d-f.avg_var_degree)*(d-f.avg_var_degree);
+        var /= nvars;
+        if (f.avg_var_degree > 0) f.var_degree_cv = std::sqrt(var)/f.avg_var_degree;
+    }
+
+    if (conf.group_indep) {
+        uint64_t in_groups = 0;
+        for(uint32_t g = 1; g < var_groups.size(); g++) {
+            if (var_groups[g].empty()) continue;
+            f.num_groups++;
+            in_groups += var_groups[g].size();
+            f.max_group_size = std::max<uint32_t>(f.max_group_size, var_groups[g].size());
+        }
+        if (f.num_groups > 0) f.avg_group_size = (double)in_groups/f.num_groups;
+    }
+}
@@ -164,6 +164,7 @@ bool Common::forward_round(
     }
 
     double start_round_time = cpuTimeTotal();
+    PhaseTimer timer(this, "forward");
 
     //start with empty independent set
     vector<uint32_t> indep;
@@ -173,17 +174,18 @@ bool Common::forward_round(
     vector<char> unknown_set;
     unknown_set.resize(orig_num_vars, 0);       // Indicator variables
     for(const auto& x: *sampling_set) {
-        cout << "x = " << x << " (forward_round)" << endl;
+        log_print(3, "x = " << x << " (forward_round)");
         unknown.push_back(x);
         unknown_set[x] = 1;
-        cout << "unknown_set[" << x << "] = " << unknown_set[x] << endl;
+        log_print(3, "unknown_set[" << x << "] = " << (int)unknown_set[x]);
     }
-    cout << "unknown.size() after init = " << unknown.size() << endl;
+    verb_print(2, "unknown.size() after init = " << unknown.size());
 
     uint32_t iter = 0;
     uint32_t not_indep = 0;
 
     double myTime = cpuTime();
+    uint64_t block_start = tracer ? tracer->now() : 0;
     vector<char> tried_var_already;
     tried_var_already.resize(orig_num_vars, 0);
 
@@ -226,6 +228,21 @@ bool Common::forward_round(
         guess_set
     );
 
+    //For the progress callback, in groups
+    uint64_t decided = 0;
+    uint64_t remaining = 0;
+    {
+        vector<char> counted(var_groups.size(), 0);
+        for(const auto& v: pick_possibilities) {
+            if (!unknown_set[v] || guess_set[v]) continue;
+            if (conf.group_indep && in_variable_group(v)) {
+                if (counted[get_group_idx(v)]) continue;
+                counted[get_group_idx(v)] = 1;
+            }
+            remaining++;
+        }
+    }
+
     vector<Lit> assumptions;
     fill_assumptions_forward(
         assumptions,
@@ -239,7 +256,7 @@ bool Common::forward_round(
     //we will mess up the solver, so this saves the state
     if (conf.assign_fwd_val) {
         assert(conf.simp == 1 && "Cannot do this without simp");
-        solver2 = new SATSolver();
+        solver2 = new SATSolver(NULL, &solver_interrupt);
         bool ret = true;
         solver2->set_up_for_arjun();
         solver->start_getting_small_clauses(
@@ -271,6 +288,9 @@ bool Common::forward_round(
     uint32_t ret_false = 0;
     uint32_t ret_true = 0;
     uint32_t ret_undef = 0;
+    uint64_t all_true = 0;
+    uint64_t all_false = 0;
+    uint64_t all_undef = 0;
     bool last_indep = true;
     vector<uint32_t> test_group;
     if (conf.verb >= 2) {
@@ -280,6 +300,20 @@ bool Common::forward_round(
         //Select var
         uint32_t test_var = var_Undef;
 
+        if (interrupted()) {
+            //Keep what was not decided: the group being tested and the
+            //untested unknowns
+            verb_print(1, "[arjun] forward interrupted at iter: " << iter);
+            if (!test_group.empty()) indep.push_back(test_group.back());
+            for(uint32_t var = 0; var < orig_num_vars; var++) {
+                if (unknown_set[var] && !guess_set[var]) {
+                    unknown_set[var] = 0;
+                    indep.push_back(var);
+                }
+            }
+            break;
+        }
+
         // If there are still variables left in the group to process, pick the
         // next variable in the group.
 
@@ -344,19 +378,20 @@ bool Common::forward_round(
         assumptions.push_back(Lit(test_var, false));
         assumptions.push_back(Lit(test_var + orig_num_vars, true));
 
-        solver->set_max_confl(conf.backw_max_confl);
         solver->set_no_confl_needed();
-
-        lbool ret = solver->solve(&assumptions);
+        lbool ret = oracle_solve(assumptions, conf.backw_max_confl, oracle_forward);
         if (ret == l_False) {
             ret_false++;
+            all_false++;
         } else if (ret == l_True) {
             ret_true++;
+            all_true++;
         } else if (ret == l_Undef) {
             ret_undef++;
+            all_undef++;
         }
 
-        cout << "ret = " << ret << endl;
+        log_print(3, "ret = " << ret);
 
         // Formula is SAT, so test_var is Independent.
         if (ret == l_Undef || ret == l_True) {
@@ -383,6 +418,25 @@ bool Common::forward_round(
             last_indep = false;
         }
 
+        //The group is decided once one of its variables is independent,
+        //or none of them were
+        if (last_indep || test_group.empty()) {
+            decided++;
+            if (remaining > 0) remaining--;
+        }
+        report_progress("forward", decided, remaining,
+            [&](vector<uint32_t>& bound) {
+                for(uint32_t var = 0; var < orig_num_vars; var++) {
+                    if (unknown_set[var] || guess_set[var]) bound.push_back(var);
+                }
+                bound.insert(bound.end(), indep.begin(), indep.end());
+                if (!test_group.empty()) {
+                    for(const auto& v: var_groups[get_group_idx(test_group.back())]) {
+                        bound.push_back(v);
+                    }
+                }
+            });
+
         //Remove test var's assumptions
         assumptions.pop_back();
         assumptions.pop_back();
@@ -423,7 +477,12 @@ bool Common::forward_round(
             }
         }
 
+        if (tracer && iter % mod == (mod-1)) {
+            tracer->span("forward_block", "iter", block_start, iter);
+            block_start = tracer->now();
+        }
         if (iter % mod == (mod-1) && conf.verb) {
+            AsyncLog::get().flush();
             cout
             << "c [arjun] iter: " << std::setw(5) << iter;
             if (mod == 1) {
@@ -475,13 +534,13 @@ bool Common::forward_round(
         if (unknown_set[var] == 0) {
             if (conf.group_indep && in_variable_group(var)) {
                 for (auto& grp_var: var_groups[get_group_idx(var)]) {
-                    cout << "unknown_set[" << grp_var << "] = " << unknown_set[grp_var] 
-                         << " (in group " << get_group_idx(var) << ")" << endl;
+                    log_print(3, "unknown_set[" << grp_var << "] = " << (int)unknown_set[grp_var]
+                        << " (in group " << get_group_idx(var) << ")");
                     if (unknown_set[grp_var] == 0) {
                         unknown.push_back(grp_var);
                         unknown_set[grp_var] = 1;
-                        cout << "Setting unknown_set[" << grp_var 
-                             << "] to 1: " << unknown_set[grp_var] << endl;
+                        log_print(3, "Setting unknown_set[" << grp_var
+                            << "] to 1: " << (int)unknown_set[grp_var]);
                     }
                 }
             } else {
@@ -498,6 +557,11 @@ bool Common::forward_round(
 
     indep.clear();
     update_sampling_set(unknown, unknown_set, indep);
+    ArjunNS::PhaseStat& ps = timer.stat();
+    ps.ret_true = all_true;
+    ps.ret_false = all_false;
+    ps.ret_undef = all_undef;
+    AsyncLog::get().flush();
     if (conf.verb) {
         cout << "c [arjun] forward round finished T: "
         << std::setprecision(2) << std::fixed << (cpuTime() - start_round_time)
@@ -0,0 +1,302 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "gismo_c.h"
+#include "arjun.h"
+#include "config.h"
+#include "presets.h"
+
+#include <cstdlib>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+using std::vector;
+using CMSat::Lit;
+
+struct gismo_solver
+{
+    ArjunNS::Arjun arjun;
+    uint32_t verb = 0;
+    uint32_t seed = 0;
+    bool sampling_set_given = false;
+    vector<uint32_t> group_of_var;
+    bool ran = false;
+    bool has_result = false;
+    vector<uint32_t> result;
+    vector<Lit> tmp;
+};
+
+// No exception may leave through the C interface
+template<class F>
+static int guarded(F f)
+{
+    try {
+        return f();
+    } catch (std::bad_alloc&) {
+        return GISMO_ERR_NOMEM;
+    } catch (...) {
+        return GISMO_ERR_INTERNAL;
+    }
+}
+
+static bool to_lit(const gismo_solver* s, int32_t l, Lit& out)
+{
+    if (l == 0 || l == INT32_MIN) return false;
+    const uint32_t var = std::abs(l)-1;
+    if (var >= gismo_num_vars(s)) return false;
+    out = Lit(var, l < 0);
+    return true;
+}
+
+GISMO_C_PUBLIC int gismo_api_version(void)
+{
+    return GISMO_C_API_VERSION;
+}
+
+GISMO_C_PUBLIC const char* gismo_strerror(int code)
+{
+    switch(code) {
+        case GISMO_OK: return "ok";
+        case GISMO_STOPPED: return "stopped by a limit or an interrupt, the result may not be minimal";
+        case GISMO_ERR_ARG: return "bad argument";
+        case GISMO_ERR_STATE: return "not possible in this state";
+        case GISMO_ERR_NOMEM: return "out of memory";
+        case GISMO_ERR_INTERNAL: return "internal error";
+        case GISMO_ERR_UNSAT: return "the formula is UNSAT, or the clause was refused";
+    }
+    return "unknown error code";
+}
+
+GISMO_C_PUBLIC gismo_solver* gismo_new(void)
+{
+    try {
+        gismo_solver* s = new gismo_solver;
+        s->arjun.set_verbosity(0);
+        s->arjun.set_group_independent_support(0);
+        return s;
+    } catch (...) {
+        return NULL;
+    }
+}
+
+GISMO_C_PUBLIC void gismo_free(gismo_solver* s)
+{
+    delete s;
+}
+
+GISMO_C_PUBLIC int gismo_reset(gismo_solver* s)
+{
+    if (s == NULL) return GISMO_ERR_ARG;
+    return guarded([&]() {
+        s->arjun.reset();
+        s->sampling_set_given = false;
+        s->group_of_var.clear();
+        s->ran = false;
+        s->has_result = false;
+        s->result.clear();
+        return GISMO_OK;
+    });
+}
+
+GISMO_C_PUBLIC int gismo_set_verbosity(gismo_solver* s, uint32_t verb)
+{
+    if (s == NULL) return GISMO_ERR_ARG;
+    s->verb = verb;
+    s->arjun.set_verbosity(verb);
+    return GISMO_OK;
+}
+
+GISMO_C_PUBLIC int gismo_set_seed(gismo_solver* s, uint32_t seed)
+{
+    if (s == NULL) return GISMO_ERR_ARG;
+    s->seed = seed;
+    s->arjun.set_seed(seed);
+    return GISMO_OK;
+}
+
+GISMO_C_PUBLIC int gismo_set_preset(gismo_solver* s, const char* name)
+{
+    if (s == NULL || name == NULL) return GISMO_ERR_ARG;
+    return guarded([&]() {
+        Config conf;
+        if (!apply_config_preset(name, conf)) return GISMO_ERR_ARG;
+        conf.verb = s->verb;
+        conf.seed = s->seed;
+        conf.group_indep = s->arjun.get_group_independent_support();
+        set_arjun_config(s->arjun, conf);
+        return GISMO_OK;
+    });
+}
+
+GISMO_C_PUBLIC int gismo_new_vars(gismo_solver* s, uint32_t num)
+{
+    if (s == NULL) return GISMO_ERR_ARG;
+    if (s->ran) return GISMO_ERR_STATE;
+    return guarded([&]() {
+        s->arjun.new_vars(num);
+        return GISMO_OK;
+    });
+}
+
+GISMO_C_PUBLIC uint32_t gismo_num_vars(const gismo_solver* s)
+{
+    if (s == NULL) return 0;
+    return s->arjun.get_orig_num_vars();
+}
+
+GISMO_C_PUBLIC int gismo_add_clauses(gismo_solver* s, const int32_t* lits, size_t num_lits)
+{
+    if (s == NULL || (lits == NULL && num_lits > 0)) return GISMO_ERR_ARG;
+    if (num_lits > 0 && lits[num_lits-1] != 0) return GISMO_ERR_ARG;
+
+    //Check all of them first, so that nothing is added on an error
+    Lit l;
+    for(size_t i = 0; i < num_lits; i++) {
+        if (lits[i] != 0 && !to_lit(s, lits[i], l)) return GISMO_ERR_ARG;
+    }
+    return guarded([&]() {
+        s->tmp.clear();
+        for(size_t i = 0; i < num_lits; i++) {
+            if (lits[i] == 0) {
+                if (!s->arjun.add_clause(s->tmp)) return GISMO_ERR_UNSAT;
+                s->tmp.clear();
+                continue;
+            }
+            to_lit(s, lits[i], l);
+            s->tmp.push_back(l);
+        }
+        return GISMO_OK;
+    });
+}
+
+GISMO_C_PUBLIC int gismo_add_bnn(
+    gismo_solver* s, const int32_t* lits, size_t num_lits, int32_t cutoff, int32_t out)
+{
+    if (s == NULL || (lits == NULL && num_lits > 0)) return GISMO_ERR_ARG;
+    if (s->ran) return GISMO_ERR_STATE;
+
+    Lit out_lit = CMSat::lit_Undef;
+    if (out != 0 && !to_lit(s, out, out_lit)) return GISMO_ERR_ARG;
+    return guarded([&]() {
+        s->tmp.clear();
+        Lit l;
+        for(size_t i = 0; i < num_lits; i++) {
+            if (!to_lit(s, lits[i], l)) return GISMO_ERR_ARG;
+            s->tmp.push_back(l);
+        }
+        if (!s->arjun.add_bnn_clause(s->tmp, cutoff, out_lit)) return GISMO_ERR_UNSAT;
+        return GISMO_OK;
+    });
+}
+
+GISMO_C_PUBLIC int gismo_set_sampling_set(gismo_solver* s, const uint32_t* vars, size_t num)
+{
+    if (s == NULL || (vars == NULL && num > 0)) return GISMO_ERR_ARG;
+    if (s->ran) return GISMO_ERR_STATE;
+    return guarded([&]() {
+        vector<uint32_t> sampl;
+        for(size_t i = 0; i < num; i++) {
+            if (vars[i] == 0 || vars[i] > gismo_num_vars(s)) return GISMO_ERR_ARG;
+            sampl.push_back(vars[i]-1);
+        }
+        s->arjun.set_starting_sampling_set(sampl);
+        s->sampling_set_given = true;
+        return GISMO_OK;
+    });
+}
+
+GISMO_C_PUBLIC int gismo_set_groups(gismo_solver* s, const uint32_t* group_of_var, size_t num_vars)
+{
+    if (s == NULL || (group_of_var == NULL && num_vars > 0)) return GISMO_ERR_ARG;
+    if (num_vars > gismo_num_vars(s)) return GISMO_ERR_ARG;
+    if (s->ran) return GISMO_ERR_STATE;
+    return guarded([&]() {
+        s->group_of_var.assign(group_of_var, group_of_var + num_vars);
+        s->arjun.set_group_independent_support(1);
+        return GISMO_OK;
+    });
+}
+
+// The groups are set here, as every variable needs an entry, including the
+// ones added since gismo_set_groups(). Group ids can be anything, they are
+// numbered 1, 2, ... in the order they are first seen
+static void set_up_for_first_run(gismo_solver* s)
+{
+    if (!s->sampling_set_given) s->arjun.start_with_clean_sampling_set();
+    if (!s->arjun.get_group_independent_support()) return;
+
+    vector<uint32_t> var2var_group(s->arjun.nVars(), 0);
+    vector<vector<uint32_t>> var_groups(1);
+    std::unordered_map<uint32_t, uint32_t> group_idx;
+    for(uint32_t v = 0; v < s->group_of_var.size(); v++) {
+        const uint32_t g = s->group_of_var[v];
+        if (g == 0) continue;
+        auto it = group_idx.insert(std::make_pair(g, (uint32_t)var_groups.size())).first;
+        if (it->second == var_groups.size()) var_groups.push_back(vector<uint32_t>());
+        var2var_group[v] = it->second;
+        var_groups[it->second].push_back(v);
+    }
+    s->arjun.set_variable_groups(var2var_group, var_groups);
+}
+
+GISMO_C_PUBLIC int gismo_run(
+    gismo_solver* s, double time_limit, uint64_t max_conflicts, uint64_t max_mem)
+{
+    if (s == NULL || time_limit < 0) return GISMO_ERR_ARG;
+    return guarded([&]() {
+        if (!s->ran) set_up_for_first_run(s);
+        s->ran = true;
+        s->has_result = false;
+        s->arjun.set_time_limit(time_limit);
+        s->arjun.set_conflict_budget_total(max_conflicts);
+        s->arjun.set_memory_limit(max_mem);
+        s->result = s->arjun.get_indep_set();
+        for(auto& v: s->result) v++;
+        s->has_result = true;
+        return s->arjun.get_run_stats().interrupted ? GISMO_STOPPED : GISMO_OK;
+    });
+}
+
+GISMO_C_PUBLIC int gismo_interrupt(gismo_solver* s)
+{
+    if (s == NULL) return GISMO_ERR_ARG;
+    s->arjun.interrupt_asap();
+    return GISMO_OK;
+}
+
+GISMO_C_PUBLIC size_t gismo_result_size(const gismo_solver* s)
+{
+    if (s == NULL || !s->has_result) return 0;
+    return s->result.size();
+}
+
+GISMO_C_PUBLIC size_t gismo_get_result(const gismo_solver* s, uint32_t* out, size_t cap)
+{
+    if (s == NULL || !s->has_result) return 0;
+    for(size_t i = 0; i < cap && i < s->result.size(); i++) out[i] = s->result[i];
+    return s->result.size();
+}
@@ -0,0 +1,123 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef GISMO_C_H
+#define GISMO_C_H
+
+/* C interface of gismo, for embedding it from C or through an FFI.
+ *
+ * Variables and literals are numbered as in DIMACS: variables from 1, a
+ * literal is a variable, negated if negative. Functions returning int return
+ * GISMO_OK, or one of the GISMO_ERR_* codes, see gismo_strerror().
+ *
+ * Thread safety: separate handles share no state and may be used from
+ * separate threads at the same time. One handle must only be used by one
+ * thread at a time, except for gismo_interrupt(), which may be called from
+ * any thread while gismo_run() is running. Note that the memory limit of
+ * gismo_run() is on the resident memory of the whole process.
+ *
+ * The layout of the handle is not part of the interface, and
+ * GISMO_C_API_VERSION only goes up when a function changes. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined _WIN32
+    #define GISMO_C_PUBLIC __declspec(dllexport)
+#else
+    #define GISMO_C_PUBLIC __attribute__ ((visibility ("default")))
+#endif
+
+#define GISMO_C_API_VERSION 1
+
+#define GISMO_OK 0
+/* gismo_run() was stopped by a limit or gismo_interrupt(). The result is an
+ * independent support, but may not be minimal */
+#define GISMO_STOPPED 1
+#define GISMO_ERR_ARG (-1)      /* bad argument, e.g. variable out of range */
+#define GISMO_ERR_STATE (-2)    /* e.g. the result asked for before gismo_run() */
+#define GISMO_ERR_NOMEM (-3)
+#define GISMO_ERR_INTERNAL (-4)
+/* The formula became UNSAT, or the solver refused the clause. Clauses after
+ * it in the same call are not added */
+#define GISMO_ERR_UNSAT (-5)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gismo_solver gismo_solver;
+
+GISMO_C_PUBLIC int gismo_api_version(void);
+GISMO_C_PUBLIC const char* gismo_strerror(int code);
+
+/* Returns NULL if out of memory. Starts with verbosity 0 and group mode off */
+GISMO_C_PUBLIC gismo_solver* gismo_new(void);
+GISMO_C_PUBLIC void gismo_free(gismo_solver* s);
+/* Forgets the formula, sampling set, groups and result, but keeps the
+ * configuration and the memory already allocated. Cheaper than
+ * gismo_free() and gismo_new() when solving many small instances */
+GISMO_C_PUBLIC int gismo_reset(gismo_solver* s);
+
+/* Configuration. A preset (e.g. "default", "simp", "guess", as given to
+ * --bench-presets of the command-line tool) resets every knob but the
+ * verbosity and the seed */
+GISMO_C_PUBLIC int gismo_set_verbosity(gismo_solver* s, uint32_t verb);
+GISMO_C_PUBLIC int gismo_set_seed(gismo_solver* s, uint32_t seed);
+GISMO_C_PUBLIC int gismo_set_preset(gismo_solver* s, const char* name);
+
+/* The formula. Clauses are given in bulk, each terminated by a 0, e.g.
+ * {1, -2, 0, 2, 3, 0}. out of a BNN constraint is 0 if it has none */
+GISMO_C_PUBLIC int gismo_new_vars(gismo_solver* s, uint32_t num);
+GISMO_C_PUBLIC uint32_t gismo_num_vars(const gismo_solver* s);
+GISMO_C_PUBLIC int gismo_add_clauses(gismo_solver* s, const int32_t* lits, size_t num_lits);
+GISMO_C_PUBLIC int gismo_add_bnn(
+    gismo_solver* s, const int32_t* lits, size_t num_lits, int32_t cutoff, int32_t out);
+
+/* The variables to find an independent support of; all of them if not set.
+ * group_of_var[i] is the group of variable i+1, 0 if it's in none. Any
+ * other value can be a group id, they don't have to be consecutive. Setting
+ * the groups turns group mode on */
+GISMO_C_PUBLIC int gismo_set_sampling_set(gismo_solver* s, const uint32_t* vars, size_t num);
+GISMO_C_PUBLIC int gismo_set_groups(gismo_solver* s, const uint32_t* group_of_var, size_t num_vars);
+
+/* Computes the independent support. Limits are 0 if unlimited: wall-clock
+ * seconds, conflicts, and bytes of resident memory. Returns GISMO_OK,
+ * GISMO_STOPPED or an error. Can be called again after adding clauses */
+GISMO_C_PUBLIC int gismo_run(
+    gismo_solver* s, double time_limit, uint64_t max_conflicts, uint64_t max_mem);
+GISMO_C_PUBLIC int gismo_interrupt(gismo_solver* s);
+
+/* Result of the last gismo_run(). gismo_get_result() writes at most cap
+ * variables to out and returns the size of the result */
+GISMO_C_PUBLIC size_t gismo_result_size(const gismo_solver* s);
+GISMO_C_PUBLIC size_t gismo_get_result(const gismo_solver* s, uint32_t* out, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GISMO_C_H */
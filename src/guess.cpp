@@ -73,6 +73,7 @@ void Common::guess_round(
     bool shuffle,
     uint32_t offset)
 {
+    TraceSpan span(tracer, "guess_round", "round");
     double start_round_time = cpuTimeTotal();
     for(const auto& x: seen) {
         assert(x == 0);
@@ -124,6 +125,7 @@ void Common::guess_round(
     }
 
     uint32_t tot_removed = 0;
+    uint64_t round_removed = 0;
     vector<Lit> assumptions;
     while(iter < guess_div) {
         //Assumption filling
@@ -140,11 +142,16 @@ void Common::guess_round(
             );
         }
 
-        solver->set_max_confl(conf.guess_max_confl);
         removed = guess_remove_and_update_ass(
             assumptions, unknown_set, dontremove_vars);
 
         tot_removed += removed;
+        round_removed += removed;
+        report_progress("guess", round_removed, unknown.size() - round_removed,
+            [&](vector<uint32_t>& bound) {
+                for(const auto& v: unknown) if (unknown_set[v]) bound.push_back(v);
+                bound.insert(bound.end(), indep.begin(), indep.end());
+            });
 
         if (iter % mod == (mod-1) && conf.verb) {
             cout
@@ -179,7 +186,7 @@ uint32_t Common::guess_remove_and_update_ass(
     uint32_t removed = 0;
     seen.resize(solver->nVars(), 0);
 
-    bool ok = solver->implied_by(assumptions, tmp_implied_by);
+    bool ok = oracle_implied_by(assumptions, tmp_implied_by, conf.guess_max_confl);
     if (!ok) {
         return 0;
     }
@@ -212,6 +219,7 @@ uint32_t Common::guess_remove_and_update_ass(
 
 void Common::run_guess()
 {
+    PhaseTimer timer(this, "guess");
     double myTime = cpuTime();
     if (conf.verb) {
         cout << "c [arjun] ============ Guess ==============" << endl;
@@ -223,7 +231,10 @@ void Common::run_guess()
         cout << "c [arjun] Simplifying for guess." << endl;
     }
     solver->set_bve(0);
-    solver->simplify(&dont_elim, NULL);
+    {
+        TraceSpan span(tracer, "simplify", "inproc");
+        solver->simplify(&dont_elim, NULL);
+    }
     if (conf.verb) {
         cout << "c [arjun] CMS::simplify() with no BVE finished. T: "
         << (cpuTime() - myTime)
@@ -0,0 +1,105 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_HEARTBEAT_H
+#define ARJUN_HEARTBEAT_H
+
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "time_mem.h"
+#include "asynclog.h"
+
+// Time-based progress line for loops that can run for hours, such as
+// backward. due() is cheap enough to call between every two solver calls;
+// beat() prints how many items were decided per second over the last few
+// beats, how many are left, when that rate would finish them, and the RSS.
+class Heartbeat
+{
+public:
+    Heartbeat(double _interval, const char* _what, uint32_t _window = 5) :
+        interval(_interval),
+        what(_what),
+        window(_window)
+    {
+        start = wallTime();
+        next = start + interval;
+        samples.push_back(std::make_pair(start, 0));
+    }
+
+    bool due() const
+    {
+        return interval > 0 && wallTime() >= next;
+    }
+
+    void beat(uint64_t decided, uint64_t remaining)
+    {
+        const double now = wallTime();
+        next = now + interval;
+
+        //Rate over the last few beats, so it follows the current speed
+        const std::pair<double, uint64_t>& old = samples.front();
+        const double elapsed = now - old.first;
+        const double rate = elapsed > 0 ? (double)(decided - old.second)/elapsed : 0;
+        samples.push_back(std::make_pair(now, decided));
+        while(samples.size() > window + 1) samples.pop_front();
+
+        double vm_usage;
+        const uint64_t rss = memUsedTotal(vm_usage);
+        AsyncLog::get().flush();
+        std::cout << "c [arjun-heartbeat]"
+        << " decided: " << decided << " " << what
+        << " rate: " << std::setprecision(2) << std::fixed << rate << "/s"
+        << " unknown: " << remaining
+        << " ETA: " << (rate > 0 ? format_secs((double)remaining/rate) : std::string("?"))
+        << " RSS: " << rss/(1024*1024) << " MB"
+        << " T: " << std::setprecision(2) << (now - start)
+        << std::endl;
+    }
+
+private:
+    static std::string format_secs(double secs)
+    {
+        const uint64_t s = (uint64_t)(secs + 0.5);
+        std::stringstream ss;
+        ss << s/3600 << ":"
+        << std::setw(2) << std::setfill('0') << (s/60)%60 << ":"
+        << std::setw(2) << std::setfill('0') << s%60;
+        return ss.str();
+    }
+
+    double interval;
+    const char* what;
+    uint32_t window;
+    double start;
+    double next;
+    std::deque<std::pair<double, uint64_t>> samples;
+};
+
+#endif //ARJUN_HEARTBEAT_H
@@ -0,0 +1,299 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "common.h"
+
+// Clauses that can be taken back are added as (C V act), and act is assumed
+// FALSE by every oracle call while the clause is active. While inactive, act
+// is left free, so the clause can be satisfied through it. Removing it sets
+// act to TRUE for good, so the clause and everything learnt from it is
+// satisfied from then on.
+//
+// Before duplication act is an ordinary variable, so it gets its copy (and
+// the copy of the clause) from duplicate_problem(). Simplification runs
+// without assuming it, i.e. on the formula without the removable clauses,
+// which only holds more solutions: what it finds stays true whichever
+// removable clauses are active. After duplication one act guards both the
+// clause and its copy.
+
+uint32_t Common::add_removable_clause(const vector<Lit>& lits, bool active)
+{
+    const uint32_t max_var = duplicated ? orig_num_vars : solver->nVars();
+    for(const Lit l: lits) {
+        if (l.var() >= max_var) return std::numeric_limits<uint32_t>::max();
+    }
+
+    Removable r;
+    r.lits = lits;
+    r.active = active;
+    solver->new_var();
+    r.acts.push_back(solver->nVars()-1);
+
+    tmp = lits;
+    tmp.push_back(Lit(r.acts[0], false));
+    solver->add_clause(tmp);
+    if (duplicated) {
+        tmp.clear();
+        for(const Lit l: lits) tmp.push_back(Lit(l.var()+orig_num_vars, l.sign()));
+        tmp.push_back(Lit(r.acts[0], false));
+        solver->add_clause(tmp);
+        if (active) note_edit(lits, false);
+    }
+    removables.push_back(r);
+    update_active_acts();
+    return removables.size()-1;
+}
+
+bool Common::set_clause_active(uint32_t id, bool active)
+{
+    if (id >= removables.size() || removables[id].removed) return false;
+
+    Removable& r = removables[id];
+    if (r.active == active) return true;
+    r.active = active;
+    if (duplicated) note_edit(r.lits, !active);
+    update_active_acts();
+    return true;
+}
+
+bool Common::remove_clause(uint32_t id)
+{
+    if (id >= removables.size() || removables[id].removed) return false;
+
+    Removable& r = removables[id];
+    r.removed = true;
+    for(const uint32_t act: r.acts) {
+        tmp.clear();
+        tmp.push_back(Lit(act, false));
+        solver->add_clause(tmp);
+    }
+    if (duplicated && r.active) note_edit(r.lits, true);
+    update_active_acts();
+    return true;
+}
+
+bool Common::add_clause_for_good(const vector<Lit>& lits)
+{
+    for(const Lit l: lits) {
+        if (l.var() >= orig_num_vars) return false;
+    }
+    tmp.clear();
+    for(const Lit l: lits) tmp.push_back(Lit(l.var()+orig_num_vars, l.sign()));
+    solver->add_clause(lits);
+    const bool ret = solver->add_clause(tmp);
+    note_edit(lits, false);
+    return ret;
+}
+
+void Common::note_edit(const vector<Lit>& lits, bool removed)
+{
+    edits.push_back(vector<uint32_t>());
+    for(const Lit l: lits) edits.back().push_back(l.var());
+    edits_removed |= removed;
+}
+
+void Common::update_active_acts()
+{
+    active_acts.clear();
+    for(const auto& r: removables) {
+        if (r.removed || !r.active) continue;
+        for(const uint32_t act: r.acts) active_acts.push_back(Lit(act, true));
+    }
+}
+
+// BVE must not eliminate them, as they are assumed later
+void Common::add_acts_to_dont_elim()
+{
+    for(const auto& r: removables) {
+        if (r.removed) continue;
+        for(const uint32_t act: r.acts) dont_elim.push_back(Lit(act, false));
+    }
+}
+
+// Called once the formula is duplicated: the activation variables added
+// before are original variables, so they now have a copy to assume, too
+void Common::fix_up_removables()
+{
+    for(auto& r: removables) {
+        if (r.acts.size() == 1 && r.acts[0] < orig_num_vars) {
+            r.acts.push_back(r.acts[0]+orig_num_vars);
+        }
+    }
+    update_active_acts();
+}
+
+const vector<Lit>& Common::with_active_acts(const vector<Lit>& assumptions)
+{
+    if (active_acts.empty()) return assumptions;
+    tmp_assumptions = active_acts;
+    tmp_assumptions.insert(tmp_assumptions.end(), assumptions.begin(), assumptions.end());
+    return tmp_assumptions;
+}
+
+static uint32_t uf_find(vector<uint32_t>& parent, uint32_t v)
+{
+    while(parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+static void uf_union(vector<uint32_t>& parent, uint32_t a, uint32_t b)
+{
+    a = uf_find(parent, a);
+    b = uf_find(parent, b);
+    if (a != b) parent[std::max(a, b)] = std::min(a, b);
+}
+
+// Whether a variable can be defined only depends on the connected component
+// of the formula it is in. So only the variables in a component that an
+// edited clause touches (with the edited clauses counted in, removed or not)
+// may have changed. In group mode, a group is affected if any of its
+// variables is
+void Common::mark_affected(vector<char>& affected)
+{
+    vector<uint32_t> parent(solver->nVars());
+    for(uint32_t i = 0; i < parent.size(); i++) parent[i] = i;
+
+    vector<Lit> cnf = get_cnf();
+    uint32_t first = var_Undef;
+    for(const Lit l: cnf) {
+        if (l == lit_Undef) {
+            first = var_Undef;
+            continue;
+        }
+        if (first == var_Undef) first = l.var();
+        else uf_union(parent, first, l.var());
+    }
+    for (const BNN* bnn: solver->get_bnns()) {
+        if (bnn == NULL) continue;
+        first = (bnn->out == lit_Undef) ? var_Undef : bnn->out.var();
+        for (const auto& l: *bnn) {
+            if (first == var_Undef) first = l.var();
+            else uf_union(parent, first, l.var());
+        }
+    }
+    for(const auto& vars: edits) {
+        for(uint32_t i = 1; i < vars.size(); i++) uf_union(parent, vars[0], vars[i]);
+    }
+
+    vector<char> touched(parent.size(), 0);
+    for(const auto& vars: edits) {
+        for(const uint32_t v: vars) touched[uf_find(parent, v)] = 1;
+    }
+    affected.assign(orig_num_vars, 0);
+    for(uint32_t v = 0; v < orig_num_vars; v++) {
+        affected[v] = touched[uf_find(parent, v)];
+    }
+
+    if (!conf.group_indep) return;
+    for(uint32_t g = 1; g < var_groups.size(); g++) {
+        bool any = false;
+        for(const auto& v: var_groups[g]) any |= (bool)affected[v];
+        if (!any) continue;
+        for(const auto& v: var_groups[g]) affected[v] = 1;
+    }
+}
+
+// Re-run of get_indep_set() after clauses were added or removed. The
+// previous set is the starting candidate:
+//  - adding clauses only removes solutions, so it stays independent, but
+//    some of its groups may have become dependent
+//  - removing clauses adds solutions, so a group left out may now be needed.
+//    Those are first re-tested against the candidate, and added to it unless
+//    the candidate defines them, which makes the candidate independent again
+// Then backward runs over the affected part of the candidate, with the rest
+// of it kept as it is.
+void Common::redo_after_edits()
+{
+    PhaseTimer timer(this, "redo_after_edits");
+    double myTime = cpuTime();
+    seen.resize(solver->nVars(), 0);
+    indep_reported.clear();
+
+    vector<char> affected;
+    mark_affected(affected);
+
+    vector<uint32_t> keep;
+    vector<uint32_t> candidate;
+    vector<char> in_candidate(orig_num_vars, 0);
+    for(const auto& v: prev_indep_set) {
+        if (v >= orig_num_vars || in_candidate[v]) continue;
+        in_candidate[v] = 1;
+        if (affected[v]) candidate.push_back(v);
+        else keep.push_back(v);
+    }
+    verb_print(1, "[arjun-incr] edits: " << edits.size()
+        << " kept: " << keep.size() << " to re-test: " << candidate.size());
+
+    uint32_t repaired = 0;
+    if (edits_removed) {
+        vector<Lit> assumptions;
+        for(const auto& v: candidates) {
+            if (in_candidate[v] || !affected[v]) continue;
+
+            vector<uint32_t> grp;
+            if (conf.group_indep && in_variable_group(v)) grp = var_groups[get_group_idx(v)];
+            else grp.push_back(v);
+
+            //Once interrupted, the rest can't be decided, so it stays in
+            lbool ret = l_Undef;
+            if (!interrupted()) {
+                assumptions.clear();
+                for(const auto& x: keep) {
+                    if (var_to_indic[x] != var_Undef) assumptions.push_back(Lit(var_to_indic[x], true));
+                }
+                for(const auto& x: candidate) {
+                    if (var_to_indic[x] != var_Undef) assumptions.push_back(Lit(var_to_indic[x], true));
+                }
+                const uint32_t orig_ass_size = assumptions.size();
+                for(const auto& x: grp) {
+                    assumptions.push_back(Lit(x, false));
+                    assumptions.push_back(Lit(x + orig_num_vars, true));
+                    ret = oracle_solve(assumptions, conf.backw_max_confl, oracle_backward);
+                    if (ret != l_False) break;
+                    assumptions.resize(orig_ass_size);
+                }
+            }
+            for(const auto& x: grp) in_candidate[x] = 1;
+            if (ret == l_False) continue;
+            candidate.insert(candidate.end(), grp.begin(), grp.end());
+            repaired++;
+        }
+        verb_print(1, "[arjun-incr] groups no longer defined: " << repaired
+            << " T: " << std::setprecision(2) << std::fixed << (cpuTime() - myTime));
+    }
+
+    *sampling_set = candidate;
+    if (conf.backward && !interrupted()) {
+        backward_round(keep);
+    } else {
+        sampling_set->insert(sampling_set->end(), keep.begin(), keep.end());
+    }
+    edits.clear();
+    edits_removed = false;
+}
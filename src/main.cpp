@@ -33,9 +33,11 @@ namespace po = boost::program_options;
 #endif
 
 #include <iostream>
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 #include <atomic>
+#include <functional>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -46,6 +48,12 @@ namespace po = boost::program_options;
 #include "arjun.h"
 #include "config.h"
 #include "dimacsparser-gis.h"
+#include "edgesparser-gis.h"
+#include "presets.h"
+#include "benchcorpus.h"
+#include "batch.h"
+#include "server.h"
+#include "jsonstr.h"
 
 
 using std::cout;
@@ -57,6 +65,10 @@ using std::string;
 using std::vector;
 
 po::options_description arjun_options = po::options_description("Arjun options");
+po::options_description bench_options = po::options_description("Corpus benchmarking options");
+po::options_description batch_options = po::options_description("Batch options");
+po::options_description server_options = po::options_description("Server options");
+po::options_description tune_options = po::options_description("Tuning options");
 po::options_description help_options;
 po::variables_map vm;
 po::positional_options_description p;
@@ -64,10 +76,91 @@ double startTime;
 Config conf;
 ArjunNS::Arjun* arjun = NULL;
 string elimtofile;
+string edgesfile;
+uint32_t idcode_k = 1;
+uint32_t idcode_kmax = 0;
+vector<uint32_t> sweep_clauses;
+int idcode_bnn = 1;
+string indstreamfile;
+string jsonoutfile;
+string traceoutfile;
+string bench_presets = "default";
+string recordqfile;
+string replayfile;
+int64_t replay_maxc = -1;
+CorpusOptions corpus;
+BatchOptions batch;
+ServeOptions serve;
+ClientOptions client;
+std::ofstream indstream;
 
 int recompute_sampling_set = 0;
 uint32_t orig_sampling_set_size = 0;
 uint32_t polar_mode = 0;
+uint64_t memlimit_mb = 0;
+string hintfile;
+bool hint_superset = false;
+int auto_config = 0;
+
+// Knobs of Config with an option of their own. With --auto, the ones given
+// on the command line are kept over the preset picked
+struct KnobOption
+{
+    string name;
+    std::function<void(Config& to, const Config& from)> copy;
+};
+vector<KnobOption> knob_options;
+
+template<class T>
+void remember_knob(const char* name, T Config::* field)
+{
+    knob_options.push_back({name, [field](Config& to, const Config& from) { to.*field = from.*field; }});
+}
+
+template<class T>
+void add_knob(const char* name, T Config::* field, const char* descr)
+{
+    tune_options.add_options()
+    (name, po::value(&(conf.*field))->default_value(conf.*field), descr);
+    remember_knob(name, field);
+}
+
+void add_tune_options()
+{
+    add_knob("simp", &Config::simp,
+        "Simplify the formula before duplicating it, and BVE on the duplicate");
+    add_knob("presimp", &Config::pre_simplify,
+        "With --simp: a round of the solver's simplifier, without BVE, first");
+    add_knob("probe", &Config::probe_based,
+        "With --simp: remove the variables failed literal probing finds defined");
+    add_knob("backbone", &Config::backbone_simpl,
+        "With --simp: find and remove the backbone of the formula");
+    add_knob("backbonemaxc", &Config::backbone_simpl_max_confl,
+        "With --backbone: conflicts per solver call");
+    add_knob("gaussj", &Config::gauss_jordan,
+        "With --simp: find XORs and run Gauss-Jordan elimination during the search");
+    add_knob("intree", &Config::intree,
+        "With --simp: in-tree probing in the solver's simplifier");
+    add_knob("distill", &Config::distill,
+        "With --simp: clause distillation in the solver's simplifier");
+    add_knob("regsimp", &Config::regularly_simplify,
+        "With --simp: let the solver simplify during the search");
+    add_knob("guess", &Config::guess,
+        "Remove groups implied by guessed ones before backward");
+    add_knob("guessmaxc", &Config::guess_max_confl,
+        "With --guess: conflicts per solver call");
+    add_knob("forward", &Config::forward,
+        "Forward round before backward");
+    add_knob("fwdgroup", &Config::forward_group,
+        "With --forward: variables tried at a time");
+    add_knob("assignfwd", &Config::assign_fwd_val,
+        "With --forward: assign the independent variables instead of assuming them. Needs --simp");
+    add_knob("backward", &Config::backward,
+        "Backward round. Without it the set is independent, but not minimal");
+    add_knob("sort", &Config::incidence_sort,
+        "Order of backward outside of group mode: 1 incidence, 2 incidence then probing, 3 probing, 6 random, 10 sum of both polarities, 11 max of them");
+    remember_knob("maxc", &Config::backw_max_confl);
+}
 
 // static void signal_handler(int) {
 //     cout << endl << "c [arjun] INTERRUPTING ***" << endl << std::flush;
@@ -88,9 +181,93 @@ void add_arjun_options()
      "Input defines grouped variables.") // by anonymous@authors.aaai23
     ("maxc", po::value(&conf.backw_max_confl)->default_value(conf.backw_max_confl),
      "Maximum conflicts per variable in backward mode")
+    ("auto", po::value(&auto_config)->default_value(auto_config),
+     "Pick the configuration from the features of the instance. Tuning options given are kept")
+    ("elimtofile", po::value(&elimtofile),
+     "Write the simplified CNF, with the independent set and its groups, to this file")
+    ("json-out", po::value(&jsonoutfile),
+     "Write the independent set and the statistics of the run to this file, in JSON")
+    ("trace-out", po::value(&traceoutfile),
+     "Write a timeline of the phases, rounds and sampled solver calls to this file, in Chrome Trace Event JSON")
+    ("recordq", po::value(&recordqfile),
+     "Log every oracle query (assumptions, budget, outcome, cost) to this file, in binary")
+    ("replay", po::value(&replayfile),
+     "Instead of computing the independent set, re-issue the queries of this log written by --recordq on the input, and compare the outcomes and costs")
+    ("replaymaxc", po::value(&replay_maxc)->default_value(replay_maxc),
+     "With --replay: conflict budget of every query. Negative means the recorded one")
+    ("timelimit", po::value(&conf.time_limit)->default_value(conf.time_limit),
+     "Stop after this many seconds (wall clock) and print the independent set found so far. 0 is no limit")
+    ("conflbudget", po::value(&conf.confl_budget_total)->default_value(conf.confl_budget_total),
+     "Stop after this many conflicts in total and print the independent set found so far. 0 is no limit")
+    ("memlimit", po::value(&memlimit_mb)->default_value(memlimit_mb),
+     "Stop once this many MB are resident and print the independent set found so far. 0 is no limit")
+    ("hint-gis", po::value(&hintfile),
+     "A candidate independent set, e.g. the 'c ind' line of an earlier run. Backward tests the groups outside of it first")
+    ("hint-superset", po::value(&hint_superset)->default_value(hint_superset),
+     "With --hint-gis: the hint is known to be independent, only test its groups")
+    ("heartbeat", po::value(&conf.heartbeat)->default_value(conf.heartbeat),
+     "Print the rate, remaining groups and ETA of backward every this many seconds. 0 turns it off")
+    ("perfcnt", po::value(&conf.perf_counters)->default_value(conf.perf_counters),
+     "Count cycles, instructions, LLC and branch misses of every phase with the hardware counters (Linux only)")
+    ("tracesample", po::value(&conf.trace_solve_every)->default_value(conf.trace_solve_every),
+     "With --trace-out: record every N-th solver call")
+    ("indstream", po::value(&indstreamfile),
+     "Stream every group to this file (e.g. a FIFO or /dev/fd/N) as soon as it is known to be in the independent set. The final set follows on the 'c ind-done' line")
+    ("edges", po::value(&edgesfile),
+     "Read an undirected graph as an edge list and build the identifying code encoding directly, instead of reading a CNF")
+    ("k", po::value(&idcode_k)->default_value(idcode_k),
+     "With --edges: at most this many nodes may be TRUE in the encoding")
+    ("kmax", po::value(&idcode_kmax)->default_value(idcode_kmax),
+     "With --edges: compute the set for every k from this down to --k, preprocessing only once")
+    ("bnn", po::value(&idcode_bnn)->default_value(idcode_bnn),
+     "With --edges: encode the cardinality constraint as a BNN constraint instead of a CNF")
     ;
 
+    bench_options.add_options()
+    ("bench-corpus", po::value(&corpus.dir),
+     "Run every instance in this directory under each of --bench-presets instead of a single input")
+    ("bench-presets", po::value(&bench_presets)->default_value(bench_presets),
+     "Comma-separated configuration presets to run the corpus with. Presets are applied on top of the other options given")
+    ("bench-timeout", po::value(&corpus.timeout)->default_value(corpus.timeout),
+     "Wall-clock timeout in seconds for every run of the corpus")
+    ("bench-db", po::value(&corpus.db_file),
+     "Write the result of every run to this CSV file")
+    ("bench-json", po::value(&corpus.json_file),
+     "Also write the results to this file in JSON")
+    ("bench-baseline", po::value(&corpus.baseline_file),
+     "Compare the results to this CSV file written earlier by --bench-db")
+    ;
+
+    batch_options.add_options()
+    ("batch", po::value(&batch.list_file),
+     "Compute the independent set of every instance listed in this file, one path per line, in this process")
+    ("jobs,j", po::value(&batch.jobs)->default_value(batch.jobs),
+     "With --batch: number of worker threads. 0 means one per hardware thread")
+    ("batch-out", po::value(&batch.out_file),
+     "With --batch: write the result and statistics of every instance to this file, one JSON object per line")
+    ;
+
+    server_options.add_options()
+    ("serve", po::value(&serve.socket_path),
+     "Listen on this Unix domain socket and compute independent sets on request, on --jobs threads, until SIGINT or SIGTERM")
+    ("serve-queue", po::value(&serve.max_queue)->default_value(serve.max_queue),
+     "With --serve: turn requests away when this many are waiting")
+    ("serve-cache", po::value(&serve.cache_size)->default_value(serve.cache_size),
+     "With --serve: keep the results of this many requests, to answer identical ones at once")
+    ("serve-max-bytes", po::value(&serve.max_request_bytes)->default_value(serve.max_request_bytes),
+     "With --serve: refuse requests whose data is longer than this many bytes")
+    ("deadline", po::value(&serve.deadline)->default_value(serve.deadline),
+     "With --serve: seconds a request may take if it doesn't say, 0 means no limit. With --connect: seconds this request may take")
+    ("connect", po::value(&client.socket_path),
+     "Send the input (or --edges) to the server listening on this socket, and print what it answers")
+    ;
+
+    add_tune_options();
     help_options.add(arjun_options);
+    help_options.add(tune_options);
+    help_options.add(bench_options);
+    help_options.add(batch_options);
+    help_options.add(server_options);
 }
 
 void add_supported_options(int argc, char** argv)
@@ -119,6 +296,7 @@ void add_supported_options(int argc, char** argv)
         }
 
         po::notify(vm);
+        conf.mem_limit = memlimit_mb*1024ULL*1024ULL;
     } catch (boost::exception_detail::clone_impl<
         boost::exception_detail::error_info_injector<po::unknown_option> >& c
     ) {
@@ -223,6 +401,96 @@ void print_final_indep_set(const vector<uint32_t>& indep_set, const vector<uint3
     << " %" << endl;
 }
 
+void write_json_out(
+    const string& input,
+    const vector<uint32_t>& indep_set,
+    const vector<uint32_t>& empty_occs,
+    double total_time)
+{
+    std::ofstream outf;
+    outf.open(jsonoutfile.c_str(), std::ios::out);
+    if (!outf) {
+        std::cerr
+        << "ERROR! Could not open file '"
+        << jsonoutfile
+        << "' for writing" << endl;
+        std::exit(-1);
+    }
+    const ArjunNS::RunStats stats = arjun->get_run_stats();
+
+    vector<uint32_t> groups;
+    for(const uint32_t v: indep_set) {
+        const uint32_t g = arjun->get_var_group(v);
+        if (g != 0) groups.push_back(g);
+    }
+    std::sort(groups.begin(), groups.end());
+    groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+
+    outf << std::setprecision(6) << std::fixed;
+    outf << "{" << endl;
+    outf << "  \"input\": " << json_str(input) << "," << endl;
+    outf << "  \"version\": " << json_str(arjun->get_version_info()) << "," << endl;
+    outf << "  \"orig_sampling_set_size\": " << orig_sampling_set_size << "," << endl;
+
+    outf << "  \"indep_vars\": [";
+    for(uint32_t i = 0; i < indep_set.size(); i++) {
+        outf << (i ? ", " : "") << indep_set[i]+1;
+    }
+    outf << "]," << endl;
+    outf << "  \"indep_groups\": [";
+    for(uint32_t i = 0; i < groups.size(); i++) {
+        outf << (i ? ", " : "") << groups[i];
+    }
+    outf << "]," << endl;
+    outf << "  \"empty_occs\": " << empty_occs.size() << "," << endl;
+
+    outf << "  \"phases\": [" << endl;
+    for(uint32_t i = 0; i < stats.phases.size(); i++) {
+        const auto& ps = stats.phases[i];
+        outf
+        << "    {\"name\": " << json_str(ps.name)
+        << ", \"wall_time\": " << ps.wall_time
+        << ", \"cpu_time\": " << ps.cpu_time
+        << ", \"conflicts\": " << ps.conflicts
+        << ", \"propagations\": " << ps.propagations
+        << ", \"rss_delta\": " << ps.rss_delta
+        << ", \"rss_peak\": " << ps.rss_peak
+        << ", \"ret_true\": " << ps.ret_true
+        << ", \"ret_false\": " << ps.ret_false
+        << ", \"ret_undef\": " << ps.ret_undef;
+        if (ps.hw_counters) {
+            outf
+            << ", \"cycles\": " << ps.cycles
+            << ", \"instructions\": " << ps.instructions
+            << ", \"llc_misses\": " << ps.llc_misses
+            << ", \"branch_misses\": " << ps.branch_misses;
+        }
+        outf
+        << "}" << (i+1 < stats.phases.size() ? "," : "") << endl;
+    }
+    outf << "  ]," << endl;
+
+    outf << "  \"conflicts\": " << stats.conflicts << "," << endl;
+    outf << "  \"mem_peak_bytes\": " << stats.mem_peak << "," << endl;
+    outf << "  \"cpu_time\": " << total_time << endl;
+    outf << "}" << endl;
+}
+
+void stream_indep(uint32_t group, const vector<uint32_t>& vars, bool done)
+{
+    //The final set, groups streamed before may not be in it
+    if (done) {
+        indstream << "c ind-done ";
+        for(const uint32_t v: vars) indstream << v+1 << " ";
+        indstream << "0" << endl;
+        return;
+    }
+
+    indstream << "c grp-ind " << group << " ";
+    for(const uint32_t v: vars) indstream << v+1 << " ";
+    indstream << "0" << endl;
+}
+
 void readInAFile(const string& filename)
 {
     #ifndef USE_ZLIB
@@ -269,25 +537,276 @@ void readInAFile(const string& filename)
     #endif
 }
 
-void dump_cnf(const std::pair<vector<vector<CMSat::Lit>>, uint32_t>& cnf, const vector<uint32_t>& sampl_set, const uint32_t multiply = 0)
+void readInEdgesFile(const string& filename)
+{
+    #ifndef USE_ZLIB
+    FILE * in = fopen(filename.c_str(), "rb");
+    EdgesParserGIS::EdgesParser<CMSat::StreamBuffer<FILE*, CMSat::FN>, ArjunNS::Arjun> parser(arjun, conf.verb);
+    #else
+    gzFile in = gzopen(filename.c_str(), "rb");
+    EdgesParserGIS::EdgesParser<CMSat::StreamBuffer<gzFile, CMSat::GZ>, ArjunNS::Arjun> parser(arjun, conf.verb);
+    #endif
+
+    if (in == NULL) {
+        std::cerr
+        << "ERROR! Could not open file '"
+        << filename
+        << "' for reading: " << strerror(errno) << endl;
+
+        std::exit(-1);
+    }
+
+    if (!parser.parse_edges(in)) {
+        exit(-1);
+    }
+    if (idcode_kmax != 0) {
+        parser.build_sweep(idcode_k, idcode_kmax, idcode_bnn);
+        sweep_clauses = parser.k_clauses;
+    } else {
+        parser.build(idcode_k, idcode_bnn);
+    }
+
+    orig_sampling_set_size = arjun->set_starting_sampling_set(parser.sampling_vars);
+    if (conf.group_indep) {
+        arjun->set_group_independent_support(conf.group_indep);
+        arjun->set_variable_groups(parser.var2var_group, parser.var_groups);
+        if (conf.verb > 1) {
+            arjun->print_var_groups();
+        }
+    }
+    #ifndef USE_ZLIB
+        fclose(in);
+    #else
+        gzclose(in);
+    #endif
+}
+
+// Applies the preset the features of the instance call for, on top of what
+// was given on the command line
+void auto_configure()
+{
+    const ArjunNS::InstanceFeatures f = arjun->get_instance_features();
+    const PresetRule& rule = pick_preset_rule(f);
+    Config picked = conf;
+    apply_config_preset(rule.preset, picked);
+    for(const auto& k: knob_options) {
+        if (vm.count(k.name) && !vm[k.name].defaulted()) k.copy(picked, conf);
+    }
+    conf = picked;
+    set_arjun_config(*arjun, conf);
+
+    cout << "c [arjun-auto] vars: " << f.num_vars
+    << " cls: " << f.num_clauses
+    << " bin: " << f.num_bin_clauses
+    << " lits: " << f.num_lits
+    << " bnns: " << f.num_bnns
+    << " sampl: " << f.sampling_set_size
+    << endl;
+    cout << "c [arjun-auto] groups: " << f.num_groups
+    << " max size: " << f.max_group_size
+    << " avg size: " << std::setprecision(2) << std::fixed << f.avg_group_size
+    << " xors: " << f.num_xors
+    << " or-gates: " << f.num_or_gates
+    << " degree avg: " << f.avg_var_degree
+    << " max: " << f.max_var_degree
+    << " cv: " << f.var_degree_cv
+    << endl;
+    cout << "c [arjun-auto] picked preset '" << rule.preset << "': " << rule.why << endl;
+}
+
+// Reads variables as written on a "c ind" line: 1-based, the "c ind" and the
+// terminating 0 are optional, and any number of lines can be given
+void read_hint_file(const string& filename)
+{
+    std::ifstream in(filename.c_str());
+    if (!in) {
+        std::cerr
+        << "ERROR! Could not open file '"
+        << filename
+        << "' for reading: " << strerror(errno) << endl;
+        std::exit(-1);
+    }
+
+    vector<uint32_t> hint;
+    string tok;
+    while(in >> tok) {
+        if (tok == "c" || tok == "ind") continue;
+        long v;
+        try {
+            v = lexical_cast<long>(tok);
+        } catch (boost::bad_lexical_cast&) {
+            v = -1;
+        }
+        if (v < 0 || v > (long)arjun->nVars()) {
+            std::cerr
+            << "ERROR! Hint file '" << filename << "' has '" << tok
+            << "', which is not a variable of the input" << endl;
+            std::exit(-1);
+        }
+        if (v != 0) hint.push_back(v-1);
+    }
+    arjun->set_hint_indep_set(hint, hint_superset);
+    cout << "c [arjun] hint size: " << hint.size()
+    << (hint_superset ? " (verified superset)" : "") << endl;
+}
+
+// Going from --kmax down to --k, every k only adds a constraint, so the
+// solver, its learnt clauses and the set of the previous k are kept
+void sweep_k()
+{
+    if (!elimtofile.empty() || !jsonoutfile.empty()) {
+        std::cerr << "ERROR! --elimtofile and --json-out can't be used with --kmax" << endl;
+        std::exit(-1);
+    }
+
+    for(uint32_t k = idcode_kmax; ; k--) {
+        const double myTime = cpuTime();
+        const uint32_t id = sweep_clauses[k-idcode_k];
+        if (k != idcode_kmax && id != std::numeric_limits<uint32_t>::max()) {
+            arjun->set_clause_active(id, true);
+        }
+        const vector<uint32_t> sampl_set = arjun->get_indep_set();
+        cout << "c k " << k << " ind ";
+        for(const uint32_t s: sampl_set) cout << s+1 << " ";
+        cout << "0" << endl;
+        cout << "c [arjun-sweep] k: " << std::setw(4) << k
+        << " set size: " << std::setw(7) << sampl_set.size()
+        << " T: " << std::setprecision(2) << std::fixed << (cpuTime() - myTime)
+        << endl;
+        if (k == idcode_k) break;
+    }
+}
+
+// Formats integers by hand into a large buffer, as going through ostream
+// for every literal takes minutes on large CNFs
+class BufferedWriter
+{
+public:
+    BufferedWriter(FILE* _out) :
+        out(_out)
+    {
+        buf.resize(bufsize);
+    }
+
+    ~BufferedWriter()
+    {
+        flush();
+    }
+
+    void write_str(const char* str)
+    {
+        for(; *str != 0; str++) write_char(*str);
+    }
+
+    void write_char(char c)
+    {
+        if (at == bufsize) flush();
+        buf[at++] = c;
+    }
+
+    void write_uint(uint64_t x)
+    {
+        char tmp[24];
+        uint32_t len = 0;
+        do {
+            tmp[len++] = '0' + (x % 10);
+            x /= 10;
+        } while (x != 0);
+        if (at + len > bufsize) flush();
+        while (len > 0) buf[at++] = tmp[--len];
+    }
+
+    void write_lit(const CMSat::Lit l)
+    {
+        if (l.sign()) write_char('-');
+        write_uint(l.var()+1);
+    }
+
+    void flush()
+    {
+        if (at == 0) return;
+        if (fwrite(buf.data(), 1, at, out) != at) {
+            std::cerr << "ERROR! Could not write to file: " << strerror(errno) << endl;
+            std::exit(-1);
+        }
+        at = 0;
+    }
+
+private:
+    static const size_t bufsize = 1024*1024;
+    FILE* out;
+    vector<char> buf;
+    size_t at = 0;
+};
+
+void dump_cnf(
+    const std::pair<vector<vector<CMSat::Lit>>, uint32_t>& cnf,
+    const vector<uint32_t>& sampl_set,
+    const uint32_t multiply,
+    const vector<vector<uint32_t>>& groups)
 {
     uint32_t num_cls = cnf.first.size();
     uint32_t max_var = cnf.second;
-    std::ofstream outf;
-    outf.open(elimtofile.c_str(), std::ios::out);
-    outf << "p cnf " << max_var << " " << num_cls << endl;
-
-    //Add projection
-    outf << "c ind ";
-    for(const auto& v: sampl_set) {
-        outf << v+1  << " ";
+    FILE* outf = fopen(elimtofile.c_str(), "wb");
+    if (outf == NULL) {
+        std::cerr
+        << "ERROR! Could not open file '"
+        << elimtofile
+        << "' for writing: " << strerror(errno) << endl;
+        std::exit(-1);
     }
-    outf << "0\n";
 
-    for(const auto& cl: cnf.first) {
-        outf << cl << " 0\n";
+    {
+        BufferedWriter w(outf);
+        w.write_str("p cnf ");
+        w.write_uint(max_var);
+        w.write_char(' ');
+        w.write_uint(num_cls);
+        w.write_char('\n');
+
+        //Add projection
+        w.write_str("c ind ");
+        for(const auto& v: sampl_set) {
+            w.write_uint(v+1);
+            w.write_char(' ');
+        }
+        w.write_str("0\n");
+
+        //Add groups, group 0 is the "no group" group. The parser gives each
+        //variable the last group it's listed in, so they must be disjoint.
+        vector<uint32_t> var_grp(max_var, 0);
+        for(uint32_t i = 1; i < groups.size(); i++) {
+            for(const auto& v: groups[i]) {
+                if (var_grp[v] != 0) {
+                    std::cerr << "ERROR! Variable " << v+1 << " is in both group "
+                    << var_grp[v] << " and " << i << " of the simplified CNF" << endl;
+                    std::exit(-1);
+                }
+                var_grp[v] = i;
+            }
+        }
+        for(uint32_t i = 1; i < groups.size(); i++) {
+            if (groups[i].empty()) continue;
+            w.write_str("c grp ");
+            for(const auto& v: groups[i]) {
+                w.write_uint(v+1);
+                w.write_char(' ');
+            }
+            w.write_str("0\n");
+        }
+
+        for(const auto& cl: cnf.first) {
+            for(const auto& l: cl) {
+                w.write_lit(l);
+                w.write_char(' ');
+            }
+            w.write_str("0\n");
+        }
+        w.write_str("c MUST MUTIPLY BY 2**");
+        w.write_uint(multiply);
+        w.write_char('\n');
     }
-    outf << "c MUST MUTIPLY BY 2**" << multiply << endl;
+    fclose(outf);
 }
 
 void elim_to_file(
@@ -298,7 +817,7 @@ void elim_to_file(
     double dump_start_time = cpuTime();
     cout << "c [arjun] dumping simplified problem to '" << elimtofile << "'" << endl;
     auto ret = arjun->get_fully_simplified_renumbered_cnf(sampl_set, empty_occs, orig_num_vars);
-    dump_cnf(std::get<0>(ret), std::get<1>(ret), std::get<2>(ret));
+    dump_cnf(std::get<0>(ret), std::get<1>(ret), std::get<2>(ret), std::get<3>(ret));
     cout << "c [arjun] Done dumping. T: " << (cpuTime() - dump_start_time) << endl;
 }
 
@@ -332,46 +851,120 @@ int main(int argc, char** argv)
     << command_line
     << endl;
 
+    if (!corpus.dir.empty()) {
+        std::stringstream ss(bench_presets);
+        string preset;
+        while(std::getline(ss, preset, ',')) {
+            if (!preset.empty()) corpus.presets.push_back(preset);
+        }
+        corpus.conf = conf;
+        int ret = run_bench_corpus(corpus);
+        delete arjun;
+        return ret;
+    }
+
+    if (!batch.list_file.empty()) {
+        batch.idcode_k = idcode_k;
+        batch.idcode_bnn = idcode_bnn;
+        batch.recompute_sampling_set = recompute_sampling_set;
+        batch.conf = conf;
+        int ret = run_batch(batch);
+        delete arjun;
+        return ret;
+    }
+
+    if (!serve.socket_path.empty()) {
+        serve.jobs = batch.jobs;
+        serve.idcode_k = idcode_k;
+        serve.idcode_bnn = idcode_bnn;
+        serve.conf = conf;
+        int ret = run_server(serve);
+        delete arjun;
+        return ret;
+    }
+
+    if (!client.socket_path.empty()) {
+        client.edges = !edgesfile.empty();
+        if (client.edges) {
+            client.input = edgesfile;
+        } else if (vm.count("input")) {
+            client.input = vm["input"].as<string>();
+        } else {
+            cout << "ERROR: you must pass a file" << endl;
+            exit(-1);
+        }
+        client.idcode_k = idcode_k;
+        client.idcode_bnn = idcode_bnn;
+        client.deadline = serve.deadline;
+        if (!vm["maxc"].defaulted()) client.maxc = conf.backw_max_confl;
+        int ret = run_client(client);
+        delete arjun;
+        return ret;
+    }
+
     double starTime = cpuTime();
     cout << "c [arjun] using seed: " << conf.seed << endl;
-    arjun->set_verbosity(conf.verb);
-    arjun->set_seed(conf.seed);
-    arjun->set_fast_backw(conf.fast_backw);
-    arjun->set_distill(conf.distill);
-    arjun->set_regularly_simplify(conf.regularly_simplify);
-    arjun->set_intree(conf.intree);
-    arjun->set_guess(conf.guess);
-    arjun->set_pre_simplify(conf.pre_simplify);
-    arjun->set_incidence_sort(conf.incidence_sort);
-    arjun->set_or_gate_based(conf.or_gate_based);
-    arjun->set_ite_gate_based(conf.ite_gate_based);
-    arjun->set_xor_gates_based(conf.xor_gates_based);
-    arjun->set_probe_based(conf.probe_based);
-    arjun->set_forward(conf.forward);
-    arjun->set_backward(conf.backward);
-    arjun->set_assign_fwd_val(conf.assign_fwd_val);
-    arjun->set_backw_max_confl(conf.backw_max_confl);
-    arjun->set_gauss_jordan(conf.gauss_jordan);
-    arjun->set_fwd_group(conf.forward_group);
-    arjun->set_backbone_simpl(conf.backbone_simpl);
-    arjun->set_irreg_gate_based(conf.irreg_gate_based);
-    arjun->set_backbone_simpl_max_confl(conf.backbone_simpl_max_confl);
-    arjun->set_simp(conf.simp);
-    arjun->set_empty_occs_based(conf.empty_occs_based);
-    arjun->set_mirror_empty(conf.mirror_empty);
+    set_arjun_config(*arjun, conf);
+    if (!traceoutfile.empty()) {
+        arjun->start_trace();
+    }
 //     if (polar_mode == 1) {
 //         arjun->set_polar_mode(CMSat::PolarityMode::polarmode_neg);
 //     }
     //signal(SIGINT,signal_handler);
 
+    if (idcode_kmax != 0 && (idcode_kmax <= idcode_k || edgesfile.empty())) {
+        std::cerr << "ERROR! --kmax must be larger than --k, and needs --edges" << endl;
+        std::exit(-1);
+    }
+
     //parsing the input
-    if (vm.count("input") == 0) {
-        cout << "ERROR: you must pass a file" << endl;
-        exit(-1);
+    string inp;
+    if (!edgesfile.empty()) {
+        inp = edgesfile;
+        readInEdgesFile(edgesfile);
+    } else {
+        if (vm.count("input") == 0) {
+            cout << "ERROR: you must pass a file" << endl;
+            exit(-1);
+        }
+        inp = vm["input"].as<string>();
+        readInAFile(inp);
     }
-    const string inp = vm["input"].as<string>();
-    readInAFile(inp);
     cout << "c [arjun] original sampling set size: " << orig_sampling_set_size << endl;
+    if (!hintfile.empty()) read_hint_file(hintfile);
+    if (auto_config) auto_configure();
+
+    if (!indstreamfile.empty()) {
+        indstream.open(indstreamfile.c_str(), std::ios::out);
+        if (!indstream) {
+            std::cerr
+            << "ERROR! Could not open file '"
+            << indstreamfile
+            << "' for writing" << endl;
+            std::exit(-1);
+        }
+        arjun->set_indep_callback(stream_indep);
+    }
+
+    if (!replayfile.empty()) {
+        const bool ok = arjun->replay_queries(replayfile, replay_maxc);
+        delete arjun;
+        return ok ? 0 : -1;
+    }
+    if (!recordqfile.empty() && !arjun->record_queries(recordqfile)) {
+        std::cerr
+        << "ERROR! Could not open file '"
+        << recordqfile
+        << "' for writing" << endl;
+        std::exit(-1);
+    }
+
+    if (!sweep_clauses.empty()) {
+        sweep_k();
+        delete arjun;
+        return 0;
+    }
 
     uint32_t orig_num_vars = arjun->nVars();
     vector<uint32_t> sampl_set = arjun->get_indep_set();
@@ -380,10 +973,22 @@ int main(int argc, char** argv)
     << "T: " << std::setprecision(2) << std::fixed << (cpuTime() - starTime)
     << endl;
 
+    if (!jsonoutfile.empty()) {
+        write_json_out(inp, sampl_set, arjun->get_empty_occ_sampl_vars(), cpuTime() - starTime);
+    }
+
     if (!elimtofile.empty()) {
         elim_to_file(sampl_set, arjun->get_empty_occ_sampl_vars(), orig_num_vars);
     }
 
+    if (!traceoutfile.empty() && !arjun->write_trace(traceoutfile)) {
+        std::cerr
+        << "ERROR! Could not write trace to file '"
+        << traceoutfile
+        << "'" << endl;
+        std::exit(-1);
+    }
+
     delete arjun;
     return 0;
 }
@@ -0,0 +1,163 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_ORACLESTATS_H
+#define ARJUN_ORACLESTATS_H
+
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cryptominisat5/solvertypesmini.h>
+
+// Histogram with power-of-two buckets: bucket b holds values in [2^(b-1), 2^b)
+// and bucket 0 holds 0. Adding is a handful of instructions, so it can sit
+// on every solver call.
+struct LogHistogram
+{
+    uint64_t buckets[65] = {};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    void add(uint64_t x)
+    {
+        uint32_t b = 0;
+        while (x >> b) b++;
+        buckets[b]++;
+        count++;
+        sum += x;
+        if (x > max) max = x;
+    }
+
+    // Upper end of the bucket the p-th percentile (0..1) falls in
+    uint64_t percentile(double p) const
+    {
+        if (count == 0) return 0;
+        const uint64_t want = (uint64_t)(p*(double)count + 0.5);
+        uint64_t at = 0;
+        for(uint32_t b = 0; b < 65; b++) {
+            at += buckets[b];
+            if (at >= want && at > 0) {
+                if (b == 0) return 0;
+                const uint64_t top = (b == 64) ? ~0ULL : ((1ULL << b) - 1);
+                return std::min(top, max);
+            }
+        }
+        return max;
+    }
+
+    double mean() const
+    {
+        return count == 0 ? 0 : (double)sum/(double)count;
+    }
+};
+
+// Cost of the oracle (SAT solver) calls of one caller, split by outcome
+struct OracleStats
+{
+    struct PerOutcome {
+        LogHistogram time_us;
+        LogHistogram conflicts;
+        LogHistogram props;
+        LogHistogram assumps;
+    };
+    PerOutcome per[3]; //indexed by outcome: TRUE, FALSE, UNDEF
+
+    static uint32_t outcome_idx(const CMSat::lbool ret)
+    {
+        if (ret == CMSat::l_True) return 0;
+        if (ret == CMSat::l_False) return 1;
+        return 2;
+    }
+
+    void add(
+        const CMSat::lbool ret,
+        uint64_t time_us,
+        uint64_t conflicts,
+        uint64_t props,
+        uint64_t assumps)
+    {
+        PerOutcome& p = per[outcome_idx(ret)];
+        p.time_us.add(time_us);
+        p.conflicts.add(conflicts);
+        p.props.add(props);
+        p.assumps.add(assumps);
+    }
+
+    uint64_t calls() const
+    {
+        return per[0].time_us.count + per[1].time_us.count + per[2].time_us.count;
+    }
+
+    void print(const std::string& name) const
+    {
+        using std::cout;
+        using std::endl;
+        using std::setw;
+        const char* outcome_names[3] = {"T", "F", "U"};
+        uint64_t total_us = 0;
+        for(const auto& p: per) total_us += p.time_us.sum;
+
+        cout << "c [arjun-oracle] " << name << " calls: " << calls()
+        << " T: " << std::setprecision(2) << std::fixed << (double)total_us/1e6
+        << endl;
+        for(uint32_t i = 0; i < 3; i++) {
+            const PerOutcome& p = per[i];
+            if (p.time_us.count == 0) continue;
+            cout << "c [arjun-oracle] " << name << " " << outcome_names[i]
+            << " calls: " << setw(8) << p.time_us.count
+            << " time share: " << setw(6) << std::setprecision(2)
+            << (total_us == 0 ? 0.0 : (double)p.time_us.sum/(double)total_us*100.0) << " %"
+            << endl;
+            print_hist("us", p.time_us, name, outcome_names[i]);
+            print_hist("confl", p.conflicts, name, outcome_names[i]);
+            print_hist("props", p.props, name, outcome_names[i]);
+            print_hist("assumps", p.assumps, name, outcome_names[i]);
+        }
+    }
+
+private:
+    static void print_hist(
+        const char* what,
+        const LogHistogram& h,
+        const std::string& name,
+        const char* outcome)
+    {
+        using std::setw;
+        std::cout << "c [arjun-oracle] " << name << " " << outcome
+        << " " << setw(8) << std::left << what << std::right
+        << " mean: " << setw(10) << std::setprecision(1) << h.mean()
+        << " p50: " << setw(10) << h.percentile(0.5)
+        << " p90: " << setw(10) << h.percentile(0.9)
+        << " p99: " << setw(10) << h.percentile(0.99)
+        << " max: " << setw(10) << h.max
+        << std::endl;
+    }
+};
+
+#endif //ARJUN_ORACLESTATS_H
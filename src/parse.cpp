@@ -0,0 +1,94 @@
+/*
+ Arjun
+
+ Copyright (c) 2020, Mate Soos and Kuldeep S. Meel.
+	       2022, Anna L.D. Latour.
+All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+// NOTE: this is kept apart from arjun.cpp, as CMS' own streambuffer.h (pulled
+//       in through common.h) clashes with the one of our grouped parser.
+
+#include "arjun.h"
+#include "dimacsparser-gis.h"
+#include "edgesparser-gis.h"
+
+#if defined _WIN32
+    #define DLL_PUBLIC __declspec(dllexport)
+#else
+    #define DLL_PUBLIC __attribute__ ((visibility ("default")))
+#endif
+
+using namespace ArjunNS;
+
+DLL_PUBLIC bool Arjun::parse_dimacs_buffer(
+    const char* data,
+    size_t len,
+    uint32_t& sampling_set_size,
+    bool recompute_sampling_set)
+{
+    DimacsParserGIS::DimacsParser<CMSat::StreamBuffer<CMSat::MemSpan, CMSat::MS>, Arjun>
+        parser(this, NULL, 0);
+
+    CMSat::MemSpan span;
+    span.at = data;
+    span.end = data + len;
+    if (!parser.parse_DIMACS(span, false)) {
+        return false;
+    }
+
+    if (!parser.sampling_vars_found || recompute_sampling_set) {
+        sampling_set_size = start_with_clean_sampling_set();
+    } else {
+        sampling_set_size = set_starting_sampling_set(parser.sampling_vars);
+    }
+    if (get_group_independent_support()) {
+        set_variable_groups(parser.var2var_group, parser.var_groups);
+    }
+
+    return true;
+}
+
+DLL_PUBLIC bool Arjun::parse_edges_buffer(
+    const char* data,
+    size_t len,
+    uint32_t k,
+    bool use_bnn,
+    uint32_t& sampling_set_size)
+{
+    EdgesParserGIS::EdgesParser<CMSat::StreamBuffer<CMSat::MemSpan, CMSat::MS>, Arjun>
+        parser(this, get_verbosity());
+
+    CMSat::MemSpan span;
+    span.at = data;
+    span.end = data + len;
+    if (!parser.parse_edges(span)) {
+        return false;
+    }
+    parser.build(k, use_bnn);
+
+    sampling_set_size = set_starting_sampling_set(parser.sampling_vars);
+    if (get_group_independent_support()) {
+        set_variable_groups(parser.var2var_group, parser.var_groups);
+    }
+
+    return true;
+}
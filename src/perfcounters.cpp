@@ -0,0 +1,109 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "perfcounters.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int open_counter(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    //this thread, any CPU
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+PerfCounters::PerfCounters()
+{
+    const uint64_t configs[num_counters] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    for(uint32_t i = 0; i < num_counters; i++) {
+        fds[i] = open_counter(PERF_TYPE_HARDWARE, configs[i]);
+        if (fds[i] >= 0) {
+            num_open++;
+        } else if (error.empty()) {
+            error = std::string("perf_event_open failed: ") + strerror(errno);
+        }
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for(uint32_t i = 0; i < num_counters; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+}
+
+PerfCounters::Values PerfCounters::read() const
+{
+    Values vals;
+    for(uint32_t i = 0; i < num_counters; i++) {
+        if (fds[i] < 0) continue;
+        uint64_t buf[3]; //value, time enabled, time running
+        if (::read(fds[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf)) continue;
+        if (buf[2] == 0) continue;
+        vals.v[i] = (buf[2] < buf[1])
+            ? (uint64_t)((double)buf[0]*(double)buf[1]/(double)buf[2])
+            : buf[0];
+        vals.valid[i] = true;
+    }
+    return vals;
+}
+
+#else
+
+PerfCounters::PerfCounters() :
+    error("hardware counters are only supported on Linux")
+{
+    for(uint32_t i = 0; i < num_counters; i++) fds[i] = -1;
+}
+
+PerfCounters::~PerfCounters()
+{
+}
+
+PerfCounters::Values PerfCounters::read() const
+{
+    return Values();
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_PERFCOUNTERS_H
+#define ARJUN_PERFCOUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+// Hardware performance counters of the calling thread, through
+// perf_event_open(2). Only on Linux, and only if the kernel lets us (see
+// /proc/sys/kernel/perf_event_paranoid); otherwise available() is FALSE,
+// why_not() says why, and read() gives zeros. Counters the CPU (or the
+// virtual machine) lacks are left out on their own, the rest still work.
+// Kernel time is not counted, so that it works with paranoid level 2.
+class PerfCounters
+{
+public:
+    enum Counter {
+        cycles = 0,
+        instructions = 1,
+        llc_misses = 2,
+        branch_misses = 3,
+        num_counters = 4
+    };
+
+    struct Values {
+        uint64_t v[num_counters] = {};
+        bool valid[num_counters] = {};
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return num_open > 0; }
+    const std::string& why_not() const { return error; }
+
+    // Current counts, scaled up for the time the kernel had to multiplex
+    // the counters out
+    Values read() const;
+
+private:
+    int fds[num_counters];
+    uint32_t num_open = 0;
+    std::string error;
+};
+
+#endif //ARJUN_PERFCOUNTERS_H
@@ -0,0 +1,156 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_PRESETS_H
+#define ARJUN_PRESETS_H
+
+#include <string>
+#include <vector>
+#include "arjun.h"
+#include "config.h"
+
+// Named configurations, so that runs over a corpus can be set up, repeated
+// and compared by name instead of by a list of options. Every preset starts
+// from the defaults of Config and only changes what its name says.
+struct ConfigPreset
+{
+    const char* name;
+    const char* descr;
+    void (*apply)(Config& conf);
+};
+
+inline const std::vector<ConfigPreset>& config_presets()
+{
+    static const std::vector<ConfigPreset> presets = {
+        {"default", "the defaults",
+            [](Config&) {}},
+        {"simp", "simplify the formula before duplicating it",
+            [](Config& c) { c.simp = 1; }},
+        {"guess", "remove groups by guessing before backward",
+            [](Config& c) { c.guess = 1; }},
+        {"forward", "forward round before backward",
+            [](Config& c) { c.forward = 1; }},
+        {"simp-guess", "simp and guess together",
+            [](Config& c) { c.simp = 1; c.guess = 1; }},
+        {"lowconfl", "backward gives up on a group after 100 conflicts",
+            [](Config& c) { c.backw_max_confl = 100; }},
+        {"highconfl", "backward gives up on a group after 5000 conflicts",
+            [](Config& c) { c.backw_max_confl = 5000; }},
+        {"gauss", "simp, with Gauss-Jordan elimination on the XORs",
+            [](Config& c) { c.simp = 1; c.gauss_jordan = 1; }},
+    };
+    return presets;
+}
+
+// Applies the preset on top of conf. Returns FALSE if there is no such preset
+inline bool apply_config_preset(const std::string& name, Config& conf)
+{
+    for(const auto& p: config_presets()) {
+        if (name == p.name) {
+            p.apply(conf);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Picks a preset from the features of an instance, for --auto. The first rule
+// that matches wins, and the last one always does. The thresholds are hand
+// set; run a corpus under the presets (see benchcorpus.h) to revisit them.
+struct PresetRule
+{
+    const char* preset;
+    const char* why;
+    bool (*matches)(const ArjunNS::InstanceFeatures& f);
+};
+
+inline const std::vector<PresetRule>& preset_rules()
+{
+    typedef ArjunNS::InstanceFeatures F;
+    static const std::vector<PresetRule> rules = {
+        {"default", "small sampling set, backward alone is cheap",
+            [](const F& f) { return f.sampling_set_size <= 64; }},
+        {"gauss", "XORs are a large part of the formula",
+            [](const F& f) { return f.num_xors >= 10 && f.num_xors*20 >= f.num_clauses; }},
+        {"simp-guess", "many OR gates, so many variables are defined by a few",
+            [](const F& f) { return f.num_or_gates*4 >= f.sampling_set_size; }},
+        {"lowconfl", "large, backward must not get stuck on hard groups",
+            [](const F& f) { return f.num_lits > 50ULL*1000ULL*1000ULL || f.sampling_set_size > 200000; }},
+        {"simp", "mostly binary clauses, so likely many equivalences",
+            [](const F& f) { return f.num_bin_clauses*2 >= f.num_clauses; }},
+        {"default", "nothing stands out",
+            [](const F&) { return true; }},
+    };
+    return rules;
+}
+
+inline const PresetRule& pick_preset_rule(const ArjunNS::InstanceFeatures& f)
+{
+    for(const auto& r: preset_rules()) {
+        if (r.matches(f)) return r;
+    }
+    return preset_rules().back();
+}
+
+// Sets every knob of conf in arjun
+inline void set_arjun_config(ArjunNS::Arjun& arjun, const Config& conf)
+{
+    arjun.set_verbosity(conf.verb);
+    arjun.set_seed(conf.seed);
+    arjun.set_fast_backw(conf.fast_backw);
+    arjun.set_distill(conf.distill);
+    arjun.set_regularly_simplify(conf.regularly_simplify);
+    arjun.set_intree(conf.intree);
+    arjun.set_guess(conf.guess);
+    arjun.set_pre_simplify(conf.pre_simplify);
+    arjun.set_incidence_sort(conf.incidence_sort);
+    arjun.set_or_gate_based(conf.or_gate_based);
+    arjun.set_ite_gate_based(conf.ite_gate_based);
+    arjun.set_xor_gates_based(conf.xor_gates_based);
+    arjun.set_probe_based(conf.probe_based);
+    arjun.set_forward(conf.forward);
+    arjun.set_backward(conf.backward);
+    arjun.set_assign_fwd_val(conf.assign_fwd_val);
+    arjun.set_backw_max_confl(conf.backw_max_confl);
+    arjun.set_gauss_jordan(conf.gauss_jordan);
+    arjun.set_fwd_group(conf.forward_group);
+    arjun.set_backbone_simpl(conf.backbone_simpl);
+    arjun.set_irreg_gate_based(conf.irreg_gate_based);
+    arjun.set_backbone_simpl_max_confl(conf.backbone_simpl_max_confl);
+    arjun.set_guess_max_confl(conf.guess_max_confl);
+    arjun.set_simp(conf.simp);
+    arjun.set_empty_occs_based(conf.empty_occs_based);
+    arjun.set_mirror_empty(conf.mirror_empty);
+    arjun.set_trace_solve_every(conf.trace_solve_every);
+    arjun.set_perf_counters(conf.perf_counters);
+    arjun.set_heartbeat(conf.heartbeat);
+    arjun.set_time_limit(conf.time_limit);
+    arjun.set_conflict_budget_total(conf.confl_budget_total);
+    arjun.set_memory_limit(conf.mem_limit);
+    arjun.set_group_independent_support(conf.group_indep);
+}
+
+#endif //ARJUN_PRESETS_H
@@ -0,0 +1,161 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "querylog.h"
+#include <cstring>
+#include <iostream>
+
+static const char query_log_magic[8] = {'G', 'I', 'S', 'M', 'O', 'Q', 'L', 1};
+
+QueryLogWriter::~QueryLogWriter()
+{
+    close();
+}
+
+bool QueryLogWriter::open(const std::string& fname, uint32_t orig_num_vars)
+{
+    close();
+    f = fopen(fname.c_str(), "wb");
+    if (!f) return false;
+    ok = true;
+    buf.clear();
+    buf.insert(buf.end(), query_log_magic, query_log_magic + sizeof(query_log_magic));
+    put(orig_num_vars);
+    return true;
+}
+
+void QueryLogWriter::put(uint64_t x)
+{
+    while(x >= 0x80) {
+        buf.push_back((unsigned char)(x | 0x80));
+        x >>= 7;
+    }
+    buf.push_back((unsigned char)x);
+}
+
+void QueryLogWriter::flush()
+{
+    if (!f || buf.empty()) return;
+    if (fwrite(buf.data(), 1, buf.size(), f) != buf.size()) ok = false;
+    buf.clear();
+}
+
+void QueryLogWriter::write(const OracleQuery& q)
+{
+    if (!f) {
+        if (!warned) {
+            std::cout << "c [arjun] WARNING: query log is closed, queries are not recorded" << std::endl;
+        }
+        warned = true;
+        return;
+    }
+    put(q.caller);
+    put(q.outcome);
+    put(q.max_confl);
+    put(q.conflicts);
+    put(q.props);
+    put(q.time_us);
+    put(q.implied);
+    put(q.lits.size());
+    for(const uint64_t l: q.lits) put(l);
+    if (buf.size() > (1U << 20)) flush();
+}
+
+bool QueryLogWriter::sync()
+{
+    if (!f) return ok;
+    flush();
+    if (fflush(f) != 0) ok = false;
+    return ok;
+}
+
+bool QueryLogWriter::close()
+{
+    if (!f) return ok;
+    flush();
+    if (fclose(f) != 0) ok = false;
+    f = NULL;
+    return ok;
+}
+
+QueryLogReader::~QueryLogReader()
+{
+    if (f) fclose(f);
+}
+
+bool QueryLogReader::open(const std::string& fname)
+{
+    f = fopen(fname.c_str(), "rb");
+    if (!f) return false;
+    char magic[sizeof(query_log_magic)];
+    uint64_t n;
+    if (fread(magic, 1, sizeof(magic), f) != sizeof(magic)
+        || memcmp(magic, query_log_magic, sizeof(magic)) != 0
+        || !get(n))
+    {
+        bad = true;
+        return false;
+    }
+    orig_num_vars = n;
+    return true;
+}
+
+bool QueryLogReader::get(uint64_t& x)
+{
+    x = 0;
+    for(uint32_t shift = 0; shift < 64; shift += 7) {
+        const int c = getc(f);
+        if (c == EOF) return false;
+        x |= (uint64_t)(c & 0x7f) << shift;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+bool QueryLogReader::next(OracleQuery& q)
+{
+    uint64_t caller;
+    if (!get(caller)) return false; //clean end of the log
+    uint64_t outcome, num_lits;
+    if (!get(outcome) || !get(q.max_confl) || !get(q.conflicts)
+        || !get(q.props) || !get(q.time_us) || !get(q.implied)
+        || !get(num_lits)
+        || num_lits > 4ULL*orig_num_vars + 16)
+    {
+        bad = true;
+        return false;
+    }
+    q.caller = caller;
+    q.outcome = outcome;
+    q.lits.resize(num_lits);
+    for(auto& l: q.lits) {
+        if (!get(l)) {
+            bad = true;
+            return false;
+        }
+    }
+    return true;
+}
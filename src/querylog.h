@@ -0,0 +1,100 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_QUERYLOG_H
+#define ARJUN_QUERYLOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// One oracle query of guess, forward or backward, as written to and read
+// back from a query log. Literals on indicator variables are stored by the
+// original variable they belong to, so that they can be mapped to the
+// indicators of a freshly duplicated solver, whatever their numbering.
+struct OracleQuery
+{
+    uint32_t caller = 0; //Common::OracleCaller
+    uint32_t outcome = 0; //0: TRUE, 1: FALSE, 2: UNDEF. For guess, TRUE if implied_by() succeeded
+    uint64_t max_confl = 0;
+    uint64_t conflicts = 0;
+    uint64_t props = 0;
+    uint64_t time_us = 0;
+    uint64_t implied = 0; //guess only, number of literals implied
+
+    //(var << 2) | (is_indicator << 1) | sign
+    std::vector<uint64_t> lits;
+
+    static uint64_t encode(uint32_t var, bool indicator, bool sign)
+    {
+        return ((uint64_t)var << 2) | ((uint64_t)indicator << 1) | (uint64_t)sign;
+    }
+    static uint32_t lit_var(uint64_t code) { return code >> 2; }
+    static bool lit_indicator(uint64_t code) { return code & 2; }
+    static bool lit_sign(uint64_t code) { return code & 1; }
+};
+
+// Compact binary log: a header, then every query as LEB128 varints
+class QueryLogWriter
+{
+public:
+    ~QueryLogWriter();
+    bool open(const std::string& fname, uint32_t orig_num_vars);
+    void write(const OracleQuery& q);
+    //Writes out what is buffered, the log stays open for later queries
+    bool sync();
+    bool close();
+
+private:
+    void put(uint64_t x);
+    void flush();
+
+    FILE* f = NULL;
+    std::vector<unsigned char> buf;
+    bool ok = true;
+    bool warned = false;
+};
+
+class QueryLogReader
+{
+public:
+    ~QueryLogReader();
+    bool open(const std::string& fname);
+    //FALSE at the end of the log, or if it is truncated (see error())
+    bool next(OracleQuery& q);
+    bool error() const { return bad; }
+    uint32_t get_orig_num_vars() const { return orig_num_vars; }
+
+private:
+    bool get(uint64_t& x);
+
+    FILE* f = NULL;
+    uint32_t orig_num_vars = 0;
+    bool bad = false;
+};
+
+#endif //ARJUN_QUERYLOG_H
@@ -0,0 +1,61 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_READFILE_H
+#define ARJUN_READFILE_H
+
+#include <cstdio>
+#include <string>
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+// Reads a whole, possibly gzipped, file into memory, for parse_dimacs_buffer()
+// and parse_edges_buffer(). Returns FALSE if it can't be opened or read.
+inline bool read_whole_file(const std::string& fname, std::string& data)
+{
+    data.clear();
+    char buf[1 << 16];
+    #ifdef USE_ZLIB
+    //gzread passes uncompressed files through as they are
+    gzFile in = gzopen(fname.c_str(), "rb");
+    if (in == NULL) return false;
+    int len;
+    while((len = gzread(in, buf, sizeof(buf))) > 0) data.append(buf, len);
+    gzclose(in);
+    return len == 0;
+    #else
+    FILE* in = fopen(fname.c_str(), "rb");
+    if (in == NULL) return false;
+    size_t len;
+    while((len = fread(buf, 1, sizeof(buf), in)) > 0) data.append(buf, len);
+    const bool ok = !ferror(in);
+    fclose(in);
+    return ok;
+    #endif
+}
+
+#endif //ARJUN_READFILE_H
@@ -0,0 +1,145 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "common.h"
+
+namespace {
+struct ReplaySummary
+{
+    uint64_t queries = 0;
+    uint64_t skipped = 0;
+    uint64_t changed[3][3] = {}; //recorded outcome -> replayed outcome
+    uint64_t rec_confl = 0;
+    uint64_t rep_confl = 0;
+    uint64_t rec_us = 0;
+    uint64_t rep_us = 0;
+};
+}
+
+// Re-issues the queries of a log written with Arjun::record_queries() on a
+// freshly preprocessed and duplicated solver, with either the recorded
+// conflict budgets or max_confl (if it's not negative), and compares the
+// outcomes and the cost with what was recorded.
+bool Common::replay_queries(const string& fname, int64_t max_confl)
+{
+    QueryLogReader in;
+    if (!in.open(fname)) {
+        cout << "c [arjun-replay] ERROR: could not read query log '" << fname << "'" << endl;
+        return false;
+    }
+    if (in.get_orig_num_vars() != solver->nVars()) {
+        cout << "c [arjun-replay] ERROR: the log was recorded on a formula with "
+        << in.get_orig_num_vars() << " variables, this one has "
+        << solver->nVars() << endl;
+        return false;
+    }
+    if (!preproc_and_duplicate()) {
+        cout << "c [arjun-replay] ERROR: the formula is UNSAT, nothing to replay" << endl;
+        return false;
+    }
+
+    ReplaySummary sum[3];
+    OracleQuery q;
+    vector<Lit> assumptions;
+    vector<Lit> implied;
+    while(in.next(q)) {
+        if (q.caller > oracle_guess || q.outcome > 2) {
+            cout << "c [arjun-replay] ERROR: malformed query in the log" << endl;
+            return false;
+        }
+        ReplaySummary& s = sum[q.caller];
+        s.queries++;
+
+        assumptions.clear();
+        bool ok = true;
+        for(const uint64_t code: q.lits) {
+            uint32_t v = OracleQuery::lit_var(code);
+            if (OracleQuery::lit_indicator(code)) {
+                //Simplification may have removed it in this configuration
+                v = v < var_to_indic.size() ? var_to_indic[v] : var_Undef;
+            }
+            if (v == var_Undef || v >= solver->nVars()) {
+                ok = false;
+                break;
+            }
+            assumptions.push_back(Lit(v, OracleQuery::lit_sign(code)));
+        }
+        if (!ok) {
+            s.skipped++;
+            continue;
+        }
+
+        const uint64_t max_confl_q = max_confl >= 0 ? (uint64_t)max_confl : q.max_confl;
+        const double start_time = wallTime();
+        const uint64_t start_confl = solver->get_sum_conflicts();
+        uint32_t outcome;
+        if (q.caller == oracle_guess) {
+            outcome = oracle_implied_by(assumptions, implied, max_confl_q) ? 0 : 1;
+        } else {
+            const lbool ret = oracle_solve(assumptions, max_confl_q, (OracleCaller)q.caller);
+            outcome = OracleStats::outcome_idx(ret);
+        }
+        s.changed[q.outcome][outcome]++;
+        s.rec_confl += q.conflicts;
+        s.rep_confl += solver->get_sum_conflicts() - start_confl;
+        s.rec_us += q.time_us;
+        s.rep_us += (uint64_t)((wallTime() - start_time)*1e6);
+    }
+    if (in.error()) {
+        cout << "c [arjun-replay] WARNING: the log is truncated, replayed what was there" << endl;
+    }
+
+    const char* names[3] = {"forward", "backward", "guess"};
+    const char* outcomes = "TFU";
+    for(uint32_t c = 0; c < 3; c++) {
+        const ReplaySummary& s = sum[c];
+        if (s.queries == 0) continue;
+        uint64_t same = 0;
+        for(uint32_t i = 0; i < 3; i++) same += s.changed[i][i];
+        cout << "c [arjun-replay] " << names[c]
+        << " queries: " << s.queries
+        << " skipped: " << s.skipped
+        << " same outcome: " << same
+        << " changed: " << (s.queries - s.skipped - same)
+        << endl;
+        cout << "c [arjun-replay] " << names[c]
+        << " conflicts rec/rep: " << s.rec_confl << "/" << s.rep_confl
+        << " time rec/rep: " << std::setprecision(2) << std::fixed
+        << (double)s.rec_us/1e6 << "/" << (double)s.rep_us/1e6 << " s"
+        << " speedup: " << (s.rep_us ? (double)s.rec_us/(double)s.rep_us : 0.0)
+        << endl;
+        for(uint32_t i = 0; i < 3; i++) {
+            for(uint32_t j = 0; j < 3; j++) {
+                if (i == j || s.changed[i][j] == 0) continue;
+                cout << "c [arjun-replay] " << names[c]
+                << " " << outcomes[i] << " -> " << outcomes[j]
+                << ": " << s.changed[i][j] << endl;
+            }
+        }
+    }
+    if (conf.verb) print_oracle_stats();
+    return true;
+}
@@ -0,0 +1,812 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "server.h"
+#include "presets.h"
+#include "readfile.h"
+#include "time_mem.h"
+#include "arjun.h"
+
+#include <iostream>
+
+#ifndef _WIN32
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+
+#ifndef _WIN32
+using std::vector;
+
+namespace {
+
+volatile sig_atomic_t stop_requested = 0;
+
+void stop_handler(int)
+{
+    stop_requested = 1;
+}
+
+bool write_all(int fd, const string& str)
+{
+    size_t at = 0;
+    while(at < str.size()) {
+        const ssize_t w = write(fd, str.data()+at, str.size()-at);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        at += w;
+    }
+    return true;
+}
+
+// Milliseconds to wait in poll() until the deadline, -1 if there is none
+int ms_left(double deadline)
+{
+    if (deadline <= 0) return -1;
+    const double left = deadline - wallTime();
+    return left <= 0 ? 0 : (int)(left*1000) + 1;
+}
+
+// The server's writes: a client that stops reading must not hold up a
+// worker, so every write gives up after send_timeout seconds
+const double send_timeout = 10;
+
+bool send_all(int fd, const string& str)
+{
+    const double deadline = wallTime() + send_timeout;
+    size_t at = 0;
+    while(at < str.size()) {
+        const ssize_t w = send(fd, str.data()+at, str.size()-at, MSG_DONTWAIT);
+        if (w >= 0) {
+            at += w;
+            continue;
+        }
+        if (errno == EINTR) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) return false;
+
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLOUT;
+        int ret;
+        while((ret = poll(&pfd, 1, ms_left(deadline))) < 0 && errno == EINTR) {}
+        if (ret <= 0) return false;
+    }
+    return true;
+}
+
+// Buffered reading of lines and raw bytes from a socket, giving up once the
+// deadline (in wallTime(), none if 0) has passed, however the bytes trickle in
+class SockReader
+{
+public:
+    SockReader(int _fd, double _deadline) :
+        fd(_fd),
+        deadline(_deadline)
+    {}
+
+    bool line(string& out)
+    {
+        size_t nl;
+        while((nl = buf.find('\n', at)) == string::npos) {
+            if (buf.size() - at > max_line || !fill()) return false;
+        }
+        out.assign(buf, at, nl-at);
+        if (!out.empty() && out.back() == '\r') out.pop_back();
+        at = nl+1;
+        return true;
+    }
+
+    bool bytes(size_t num, string& out)
+    {
+        out.assign(buf, at, std::min(num, buf.size()-at));
+        at += out.size();
+        char tmp[1 << 16];
+        while(out.size() < num) {
+            if (!wait_readable()) return false;
+            const ssize_t r = read(fd, tmp, std::min(sizeof(tmp), num - out.size()));
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            out.append(tmp, r);
+        }
+        return true;
+    }
+
+private:
+    bool wait_readable()
+    {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        int ret;
+        while((ret = poll(&pfd, 1, ms_left(deadline))) < 0 && errno == EINTR) {}
+        return ret > 0;
+    }
+
+    bool fill()
+    {
+        if (at > 0) {
+            buf.erase(0, at);
+            at = 0;
+        }
+        char tmp[4096];
+        while(true) {
+            if (!wait_readable()) return false;
+            const ssize_t r = read(fd, tmp, sizeof(tmp));
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            buf.append(tmp, r);
+            return true;
+        }
+    }
+
+    static const size_t max_line = 4096;
+    int fd;
+    double deadline;
+    string buf;
+    size_t at = 0;
+};
+
+bool fill_sockaddr(const string& path, struct sockaddr_un& addr)
+{
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    memcpy(addr.sun_path, path.c_str(), path.size()+1);
+    return true;
+}
+
+struct Request
+{
+    int fd = -1;
+    bool client_gone = false; //a write failed or timed out, don't try again
+    string format = "cnf";
+    uint32_t k = 1;
+    bool bnn = true;
+    double deadline = 0; //absolute, in wallTime(). 0 means none
+    int64_t maxc = -1;
+    string preset;
+    string data;
+
+    //Identifies the request for the cache: everything but the deadline
+    string key() const
+    {
+        std::stringstream ss;
+        ss << format << " " << k << " " << bnn << " " << maxc << " " << preset << " ";
+        return ss.str();
+    }
+};
+
+struct Result
+{
+    string status = "error";
+    string message;
+    vector<uint32_t> indep;
+    uint32_t orig_size = 0;
+    uint32_t groups = 0;
+    double wall_time = 0;
+    double cpu_time = 0;
+    uint64_t conflicts = 0;
+};
+
+string format_result(const Result& r, bool cached)
+{
+    std::stringstream ss;
+    ss << "status " << r.status;
+    if (!r.message.empty()) ss << " " << r.message;
+    ss << "\n";
+    if (r.status != "error") {
+        ss << "ind ";
+        for(const uint32_t v: r.indep) ss << v+1 << " ";
+        ss << "0\n";
+        ss << std::setprecision(6) << std::fixed
+        << "stats orig " << r.orig_size
+        << " size " << r.indep.size()
+        << " groups " << r.groups
+        << " wall " << r.wall_time
+        << " cpu " << r.cpu_time
+        << " conflicts " << r.conflicts
+        << " cached " << (int)cached << "\n";
+    }
+    ss << "end\n";
+    return ss.str();
+}
+
+// Finished results by request, least recently used first out. The formula
+// is not kept, only its length and two independent 64-bit hashes of it, so
+// a cache of large formulas stays small. A hit on a collision would need
+// both hashes and the length to match.
+class ResultCache
+{
+public:
+    explicit ResultCache(size_t _max_size) : max_size(_max_size) {}
+
+    bool get(const string& key, const string& data, Result& out)
+    {
+        const Key k = make_key(key, data);
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = entries.find(k);
+        if (it == entries.end()) return false;
+        order.splice(order.end(), order, it->second.second);
+        out = it->second.first;
+        return true;
+    }
+
+    void put(const string& key, const string& data, const Result& r)
+    {
+        if (max_size == 0) return;
+        const Key k = make_key(key, data);
+        std::lock_guard<std::mutex> lock(mtx);
+        if (entries.count(k)) return;
+        while(entries.size() >= max_size) {
+            entries.erase(order.front());
+            order.pop_front();
+        }
+        order.push_back(k);
+        entries[k] = std::make_pair(r, std::prev(order.end()));
+    }
+
+private:
+    struct Key {
+        string key; //the options, short
+        uint64_t len;
+        uint64_t fnv;
+        uint64_t hash;
+        bool operator<(const Key& o) const {
+            if (len != o.len) return len < o.len;
+            if (fnv != o.fnv) return fnv < o.fnv;
+            if (hash != o.hash) return hash < o.hash;
+            return key < o.key;
+        }
+    };
+
+    static Key make_key(const string& key, const string& data)
+    {
+        uint64_t fnv = 14695981039346656037ULL;
+        for(const char c: data) {
+            fnv ^= (unsigned char)c;
+            fnv *= 1099511628211ULL;
+        }
+        return Key{key, data.size(), fnv, std::hash<string>()(data)};
+    }
+
+    size_t max_size;
+    std::mutex mtx;
+    std::list<Key> order;
+    std::map<Key, std::pair<Result, std::list<Key>::iterator>> entries;
+};
+
+class Server
+{
+public:
+    explicit Server(const ServeOptions& _opts) :
+        opts(_opts),
+        cache(_opts.cache_size)
+    {}
+
+    int run();
+
+private:
+    struct Slot {
+        ArjunNS::Arjun* arjun = NULL;
+        double deadline = 0;
+        bool interrupted = false;
+    };
+
+    bool read_request(int fd, Request& req, string& err);
+    void serve_connection(int fd);
+    void reader();
+    void worker(uint32_t slot_at);
+    void watchdog();
+    Result solve(Request& req, uint32_t slot_at);
+
+    const ServeOptions& opts;
+    ResultCache cache;
+    int listen_fd = -1;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Request*> queue;
+    std::condition_variable conns_cv;
+    std::deque<int> conns; //accepted, request not read yet
+    vector<Slot> slots;
+    bool stopping = false;
+};
+
+// Sending the request may take this long in total
+const double read_timeout = 30;
+
+// Sends to the client of a request, unless an earlier send failed
+bool send_to(Request& req, const string& str)
+{
+    if (req.client_gone) return false;
+    if (!send_all(req.fd, str)) req.client_gone = true;
+    return !req.client_gone;
+}
+
+bool Server::read_request(int fd, Request& req, string& err)
+{
+    SockReader in(fd, wallTime() + read_timeout);
+    string line;
+    if (!in.line(line) || line != "gismo 1") {
+        err = "expected 'gismo 1'";
+        return false;
+    }
+    req.k = opts.idcode_k;
+    req.bnn = opts.idcode_bnn;
+    double deadline = opts.deadline;
+    while(true) {
+        if (!in.line(line)) {
+            err = "unexpected end of request";
+            return false;
+        }
+        std::stringstream ss(line);
+        string key;
+        ss >> key;
+        if (key.empty()) continue;
+        if (key == "format") ss >> req.format;
+        else if (key == "k") ss >> req.k;
+        else if (key == "bnn") ss >> req.bnn;
+        else if (key == "deadline") ss >> deadline;
+        else if (key == "maxc") ss >> req.maxc;
+        else if (key == "preset") ss >> req.preset;
+        else if (key == "data") {
+            uint64_t len;
+            ss >> len;
+            if (ss.fail()) {
+                err = "bad data length";
+                return false;
+            }
+            if (len > opts.max_request_bytes) {
+                err = "data longer than " + std::to_string(opts.max_request_bytes) + " bytes";
+                return false;
+            }
+            if (!in.bytes(len, req.data)) {
+                err = "unexpected end of data";
+                return false;
+            }
+            break;
+        } else {
+            err = "unknown key '" + key + "'";
+            return false;
+        }
+        if (ss.fail()) {
+            err = "bad value for '" + key + "'";
+            return false;
+        }
+    }
+    if (req.format != "cnf" && req.format != "edges") {
+        err = "unknown format '" + req.format + "'";
+        return false;
+    }
+    Config c;
+    if (!req.preset.empty() && !apply_config_preset(req.preset, c)) {
+        err = "unknown preset '" + req.preset + "'";
+        return false;
+    }
+    if (deadline > 0) req.deadline = wallTime() + deadline;
+    return true;
+}
+
+// Reads the request and either answers it from the cache or queues it.
+// Runs on the reader threads, a client that stalls while sending holds up
+// one of them for at most the read timeout, and never the accepting thread
+void Server::serve_connection(int fd)
+{
+    Request* req = new Request;
+    req->fd = fd;
+    string err;
+    if (!read_request(fd, *req, err)) {
+        Result r;
+        r.message = err;
+        send_to(*req, format_result(r, false));
+        close(fd);
+        delete req;
+        return;
+    }
+
+    Result cached;
+    if (cache.get(req->key(), req->data, cached)) {
+        send_to(*req, format_result(cached, true));
+        close(fd);
+        delete req;
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mtx);
+    if (stopping || queue.size() >= opts.max_queue) {
+        lock.unlock();
+        Result r;
+        r.message = stopping ? "server shutting down" : "busy, too many requests queued";
+        send_to(*req, format_result(r, false));
+        close(fd);
+        delete req;
+        return;
+    }
+    queue.push_back(req);
+    std::stringstream ss;
+    ss << "queued " << queue.size() << "\n";
+    //Under the lock, so it must not wait. Nothing was sent yet, so all of it
+    //fits in the socket buffer
+    const string queued = ss.str();
+    if (send(fd, queued.data(), queued.size(), MSG_DONTWAIT) != (ssize_t)queued.size()) {
+        req->client_gone = true;
+    }
+    cv.notify_one();
+}
+
+void Server::reader()
+{
+    while(true) {
+        int fd;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            conns_cv.wait(lock, [&]{ return stopping || !conns.empty(); });
+            if (conns.empty()) return;
+            fd = conns.front();
+            conns.pop_front();
+        }
+        serve_connection(fd);
+    }
+}
+
+Result Server::solve(Request& req, uint32_t slot_at)
+{
+    Result res;
+    Config conf = opts.conf;
+    if (!req.preset.empty()) apply_config_preset(req.preset, conf);
+    if (req.maxc >= 0) conf.backw_max_confl = req.maxc;
+    //Many requests run at once, their output would be interleaved
+    if (conf.verb < 2) conf.verb = 0;
+
+    const double start_wall = wallTime();
+    const double start_cpu = cpuTime(); //of this thread
+    ArjunNS::Arjun arjun;
+    set_arjun_config(arjun, conf);
+    bool ok;
+    if (req.format == "edges") {
+        ok = arjun.parse_edges_buffer(req.data.data(), req.data.size(),
+            req.k, req.bnn, res.orig_size);
+    } else {
+        ok = arjun.parse_dimacs_buffer(req.data.data(), req.data.size(), res.orig_size);
+    }
+    if (!ok) {
+        res.message = "could not parse the formula";
+        return res;
+    }
+
+    //Stream the groups as they are decided. If the client went away or
+    //stopped reading, there is no point going on
+    arjun.set_indep_callback(
+        [&req, &arjun](uint32_t group, const vector<uint32_t>& vars, bool done) {
+            if (done) return;
+            std::stringstream ss;
+            ss << "grp-ind " << group << " ";
+            for(const uint32_t v: vars) ss << v+1 << " ";
+            ss << "0\n";
+            if (!send_to(req, ss.str())) arjun.interrupt_asap();
+        });
+    double last_progress = wallTime();
+    arjun.set_progress_callback(
+        [&req, &last_progress](const ArjunNS::Progress& p) {
+            const double now = wallTime();
+            if (now - last_progress < 0.5) return true;
+            last_progress = now;
+            std::stringstream ss;
+            ss << "progress " << p.phase << " " << p.decided << " " << p.remaining << "\n";
+            return send_to(req, ss.str());
+        });
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        slots[slot_at].arjun = &arjun;
+        slots[slot_at].deadline = req.deadline;
+        slots[slot_at].interrupted = false;
+        if (stopping) arjun.interrupt_asap();
+    }
+    res.indep = arjun.get_indep_set();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        slots[slot_at].arjun = NULL;
+    }
+
+    res.wall_time = wallTime() - start_wall;
+    res.cpu_time = cpuTime() - start_cpu;
+    std::set<uint32_t> groups;
+    for(const uint32_t v: res.indep) {
+        const uint32_t g = arjun.get_var_group(v);
+        //variables outside of any group count as a group of their own
+        groups.insert(g == 0 ? (1U << 31) + v : g);
+    }
+    res.groups = groups.size();
+    const ArjunNS::RunStats stats = arjun.get_run_stats();
+    res.conflicts = stats.conflicts;
+    res.status = stats.interrupted ? "timeout" : "ok";
+    return res;
+}
+
+void Server::worker(uint32_t slot_at)
+{
+    while(true) {
+        Request* req;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [&]{ return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            req = queue.front();
+            queue.pop_front();
+        }
+
+        send_to(*req, "running\n");
+        const Result res = solve(*req, slot_at);
+        send_to(*req, format_result(res, false));
+        if (res.status == "ok") cache.put(req->key(), req->data, res);
+        close(req->fd);
+        delete req;
+    }
+}
+
+// Interrupts the requests that ran past their deadline, and all of them
+// when shutting down
+void Server::watchdog()
+{
+    while(true) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            const double now = wallTime();
+            for(Slot& s: slots) {
+                if (s.arjun == NULL || s.interrupted) continue;
+                if (stopping || (s.deadline > 0 && now >= s.deadline)) {
+                    s.arjun->interrupt_asap();
+                    s.interrupted = true;
+                }
+            }
+            if (stopping) {
+                bool any = false;
+                for(const Slot& s: slots) any |= s.arjun != NULL;
+                if (!any && queue.empty() && conns.empty()) return;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+int Server::run()
+{
+    struct sockaddr_un addr;
+    if (!fill_sockaddr(opts.socket_path, addr)) {
+        cerr << "ERROR! Socket path '" << opts.socket_path << "' is too long" << endl;
+        return -1;
+    }
+
+    //A socket file nobody listens on is left over from an earlier run
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        cerr << "ERROR! Could not create socket: " << strerror(errno) << endl;
+        return -1;
+    }
+    if (connect(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) == 0) {
+        cerr << "ERROR! A server is already listening on '" << opts.socket_path << "'" << endl;
+        close(listen_fd);
+        return -1;
+    }
+    close(listen_fd);
+    unlink(opts.socket_path.c_str());
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0
+        || bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0
+        || listen(listen_fd, 64) != 0)
+    {
+        cerr << "ERROR! Could not listen on '" << opts.socket_path << "': " << strerror(errno) << endl;
+        if (listen_fd >= 0) close(listen_fd);
+        return -1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, stop_handler);
+    signal(SIGTERM, stop_handler);
+
+    uint32_t jobs = opts.jobs;
+    if (jobs == 0) jobs = std::max(1U, std::thread::hardware_concurrency());
+    slots.resize(jobs);
+    vector<std::thread> threads;
+    for(uint32_t i = 0; i < jobs; i++) threads.push_back(std::thread(&Server::worker, this, i));
+    //Reading is cheap next to solving, these only wait for slow clients
+    vector<std::thread> readers;
+    for(uint32_t i = 0; i < std::max(jobs, 4U); i++) readers.push_back(std::thread(&Server::reader, this));
+    std::thread watch(&Server::watchdog, this);
+
+    if (opts.conf.verb) {
+        cout << "c [arjun-server] listening on '" << opts.socket_path << "'"
+        << " jobs: " << jobs
+        << " max queue: " << opts.max_queue
+        << " default deadline: " << opts.deadline << endl;
+    }
+
+    uint64_t served = 0;
+    while(!stop_requested) {
+        struct pollfd pfd;
+        pfd.fd = listen_fd;
+        pfd.events = POLLIN;
+        const int ret = poll(&pfd, 1, 200);
+        if (ret <= 0) continue;
+        const int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        served++;
+        std::unique_lock<std::mutex> lock(mtx);
+        if (conns.size() >= opts.max_queue) {
+            lock.unlock();
+            Result r;
+            r.message = "busy, too many connections waiting";
+            send_all(fd, format_result(r, false));
+            close(fd);
+            continue;
+        }
+        conns.push_back(fd);
+        conns_cv.notify_one();
+    }
+
+    if (opts.conf.verb) {
+        cout << "c [arjun-server] stopping, connections served: " << served << endl;
+    }
+    close(listen_fd);
+    unlink(opts.socket_path.c_str());
+
+    //Turn away what is still queued or not read yet, interrupt what runs
+    vector<int> unread;
+    vector<Request*> queued;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+        unread.assign(conns.begin(), conns.end());
+        conns.clear();
+        queued.assign(queue.begin(), queue.end());
+        queue.clear();
+    }
+    cv.notify_all();
+    conns_cv.notify_all();
+    Result r;
+    r.message = "server shutting down";
+    const string bye = format_result(r, false);
+    for(const int fd: unread) {
+        send_all(fd, bye);
+        close(fd);
+    }
+    for(Request* req: queued) {
+        send_to(*req, bye);
+        close(req->fd);
+        delete req;
+    }
+    for(auto& t: readers) t.join();
+    for(auto& t: threads) t.join();
+    watch.join();
+    return 0;
+}
+
+}
+
+int run_server(const ServeOptions& opts)
+{
+    Server server(opts);
+    return server.run();
+}
+
+int run_client(const ClientOptions& opts)
+{
+    string data;
+    if (!read_whole_file(opts.input, data)) {
+        cerr << "ERROR! Could not read file '" << opts.input << "'" << endl;
+        return -1;
+    }
+
+    struct sockaddr_un addr;
+    if (!fill_sockaddr(opts.socket_path, addr)) {
+        cerr << "ERROR! Socket path '" << opts.socket_path << "' is too long" << endl;
+        return -1;
+    }
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        cerr << "ERROR! Could not connect to '" << opts.socket_path << "': " << strerror(errno) << endl;
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    std::stringstream ss;
+    ss << "gismo 1\n";
+    ss << "format " << (opts.edges ? "edges" : "cnf") << "\n";
+    if (opts.edges) {
+        ss << "k " << opts.idcode_k << "\n";
+        ss << "bnn " << opts.idcode_bnn << "\n";
+    }
+    if (opts.deadline > 0) ss << "deadline " << opts.deadline << "\n";
+    if (opts.maxc >= 0) ss << "maxc " << opts.maxc << "\n";
+    ss << "data " << data.size() << "\n";
+    if (!write_all(fd, ss.str()) || !write_all(fd, data)) {
+        cerr << "ERROR! Could not send the request: " << strerror(errno) << endl;
+        close(fd);
+        return -1;
+    }
+    string().swap(data);
+
+    //Print everything until "end", the server enforces the deadline
+    SockReader in(fd, 0);
+    string line;
+    string status;
+    while(in.line(line)) {
+        cout << line << endl;
+        if (line.compare(0, 7, "status ") == 0) {
+            std::stringstream ls(line.substr(7));
+            ls >> status;
+        }
+        if (line == "end") break;
+    }
+    close(fd);
+    if (status.empty()) {
+        cerr << "ERROR! Connection closed before an answer came" << endl;
+        return -1;
+    }
+    return status == "error" ? -1 : 0;
+}
+
+#else
+
+int run_server(const ServeOptions&)
+{
+    cerr << "ERROR! --serve is not supported on Windows" << endl;
+    return -1;
+}
+
+int run_client(const ClientOptions&)
+{
+    cerr << "ERROR! --connect is not supported on Windows" << endl;
+    return -1;
+}
+
+#endif
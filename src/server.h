@@ -0,0 +1,90 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_SERVER_H
+#define ARJUN_SERVER_H
+
+#include <string>
+#include "config.h"
+
+// Serves independent set requests over a Unix domain socket, so that callers
+// that need many of them don't pay a process start each, and identical
+// requests are answered from a cache. One request per connection. The
+// request is a header of "key value" lines, then the formula:
+//
+//   gismo 1
+//   format cnf           (or edges)
+//   k 1                  (edges only, defaults to --k)
+//   bnn 1                (edges only, defaults to --bnn)
+//   deadline 10          (seconds, counted from when it was read)
+//   maxc 1000            (conflicts per group in backward)
+//   preset guess         (see presets.h)
+//   data <bytes>
+//   <bytes of grouped DIMACS or edge list>
+//
+// All keys but data are optional. The answer is streamed back as lines:
+// "queued <position>", "running", one "grp-ind <group> <vars> 0" per group
+// as soon as it is known to be in the set, "progress <phase> <decided>
+// <remaining>" every half a second or so, then "status ok|timeout|error
+// [message]", "ind <vars> 0", "stats ..." and finally "end". On timeout the
+// set is still independent, but may not be minimal. Only the "ind" line is
+// final: a streamed group may be missing from it, e.g. if the formula turned
+// out to be UNSAT.
+//
+// The whole request must arrive within 30 seconds, and its data may be at
+// most max_request_bytes long. A client that stops
+// reading the answer for 10 seconds is dropped, and its request stopped.
+struct ServeOptions
+{
+    std::string socket_path;
+    uint32_t jobs = 0; //0 means one per hardware thread
+    uint32_t max_queue = 64; //requests waiting beyond this are turned away
+    double deadline = 0; //for requests that don't set one, 0 means none
+    uint32_t cache_size = 64; //number of results kept
+    uint64_t max_request_bytes = 64ULL << 20; //longer data is refused
+    uint32_t idcode_k = 1;
+    bool idcode_bnn = true;
+    Config conf;
+};
+
+//Runs until SIGINT or SIGTERM
+int run_server(const ServeOptions& opts);
+
+// Sends one request to a server and prints what comes back. For testing.
+struct ClientOptions
+{
+    std::string socket_path;
+    std::string input;
+    bool edges = false;
+    uint32_t idcode_k = 1;
+    bool idcode_bnn = true;
+    double deadline = 0;
+    int64_t maxc = -1; //-1: the server's
+};
+
+int run_client(const ClientOptions& opts);
+
+#endif //ARJUN_SERVER_H
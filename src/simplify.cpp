@@ -48,23 +48,27 @@ bool Common::simplify()
     auto old_size = sampling_set->size();
     double myTime = cpuTime();
 
-    if (conf.pre_simplify) {
+    if (conf.pre_simplify && start_optional("pre_simplify")) {
         verb_print(1, "[arjun-simp] CMS::simplify() with no BVE, intree probe...");
         double simpTime = cpuTime();
         solver->set_bve(0);
         solver->set_intree_probe(1);
-        if (solver->simplify() == l_False) return false;
+        const lbool ret = solver->simplify();
+        end_optional();
+        if (ret == l_False) return false;
         solver->set_intree_probe(conf.intree);
         verb_print(1,"[arjun-simp] CMS::simplify() with no BVE finished."
             << " T: " << (cpuTime() - simpTime));
     }
 
-    if (conf.backbone_simpl) {
-        if (!backbone_simpl()) return false;
-    } else {
+    if (conf.backbone_simpl && start_optional("backbone_simpl")) {
+        const bool ok = backbone_simpl();
+        end_optional();
+        if (!ok) return false;
+    } else if (!interrupted()) {
         // Find at least one solution (so it's not UNSAT) within some timeout
         solver->set_verbosity(0);
-        solver->set_max_confl(1000);
+        solver->set_max_confl(budget_confl(1000));
         lbool ret = solver->solve();
         if (ret == l_True) definitely_satisfiable = true;
         solver->set_verbosity(std::max<int>((int)conf.verb-2, 0));
@@ -72,7 +76,11 @@ bool Common::simplify()
 
     remove_eq_literals();
     remove_zero_assigned_literals();
-    if (conf.probe_based && !probe_all()) return false;
+    if (conf.probe_based && start_optional("probe_all")) {
+        const bool ok = probe_all();
+        end_optional();
+        if (!ok) return false;
+    }
     solver->set_verbosity(std::max<int>((int)conf.verb-2, 0));
 
     verb_print(1, "[arjun] simplification finished "
@@ -105,7 +113,7 @@ bool Common::backbone_simpl()
         cout << "c [backbone-simpl] starting backbone simplification..." << endl;
     }
     uint64_t last_sum_conflicts = 0;
-    int64_t max_confl = conf.backbone_simpl_max_confl;
+    int64_t max_confl = budget_confl(conf.backbone_simpl_max_confl);
 
     solver->set_verbosity(0);
     double myTime = cpuTime();
@@ -152,6 +160,7 @@ bool Common::backbone_simpl()
     model_enabled.resize(solver->nVars(), 1);
 
     for(const uint32_t var: var_order) {
+        if (solver_interrupt.load()) goto end;
         if (!model_enabled[var]) {
             continue;
         }
@@ -242,6 +251,7 @@ bool Common::probe_all()
 
     incidence_probing.resize(orig_num_vars, 0);
     for(auto v: *sampling_set) {
+        if (solver_interrupt.load()) break;
         uint32_t min_props = 0;
         Lit l(v, false);
         if(solver->probe(l, min_props) == l_False) {
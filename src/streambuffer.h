@@ -20,12 +20,14 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #pragma once
 
 #include <stdio.h>
+#include <string.h>
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <string>
 #include <memory>
 #include <cmath>
+#include <algorithm>
 
 using std::numeric_limits;
 
@@ -54,17 +56,28 @@ struct FN {
 struct CH {
     static inline int read(void* buf, size_t num, size_t count, const char*& f)
     {
-        int toread = num*count;
-        char* mybuf = (char*)buf;
-
-        int read = 0;
-        while(*f != 0 && read < toread) {
-            *mybuf = *f;
-            mybuf++;
-            f++;
-            read++;
-        }
-        return read;
+        size_t toread = num*count;
+        const char* zero = (const char*)memchr(f, 0, toread);
+        if (zero != NULL) toread = zero - f;
+        memcpy(buf, f, toread);
+        f += toread;
+        return toread;
+    }
+};
+
+// A chunk of memory that is not necessarily zero-terminated
+struct MemSpan {
+    const char* at;
+    const char* end;
+};
+
+struct MS {
+    static inline int read(void* buf, size_t num, size_t count, MemSpan& f)
+    {
+        size_t toread = std::min<size_t>(num*count, f.end - f.at);
+        memcpy(buf, f.at, toread);
+        f.at += toread;
+        return toread;
     }
 };
 
@@ -121,12 +134,21 @@ public:
     void skipLine()
     {
         for (;;) {
-            if (value() == EOF || value() == '\0') return;
-            if (value() == '\n') {
+            if (pos >= size) return;
+            const char* start = buf.get() + pos;
+            const char* nl = (const char*)memchr(start, '\n', size - pos);
+            const size_t upto = (nl == NULL) ? (size - pos) : (nl - start);
+            const char* zero = (const char*)memchr(start, '\0', upto);
+            if (zero != NULL) {
+                pos += zero - start;
+                return;
+            }
+            pos += upto;
+            if (nl != NULL) {
                 advance();
                 return;
             }
-            advance();
+            assureLookahead();
         }
     }
 
@@ -30,8 +30,15 @@ THE SOFTWARE.
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <chrono>
 #include <signal.h>
 
+static inline double wallTime(void)
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 // note: MinGW64 defines both __MINGW32__ and __MINGW64__
 #if defined (_MSC_VER) || defined (__MINGW32__) || defined(_WIN32)
 #include <ctime>
@@ -78,6 +85,26 @@ static inline double cpuTimeTotal(void)
 
 #endif
 
+// High-water mark of the resident set size of the process, in bytes, or 0
+// if it cannot be determined.
+#if defined (_MSC_VER) || defined (__MINGW32__) || defined(_WIN32)
+static inline uint64_t memPeakTotal()
+{
+    return 0;
+}
+#else
+static inline uint64_t memPeakTotal()
+{
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+    #if defined(__APPLE__)
+    return ru.ru_maxrss;
+    #else
+    return (uint64_t)ru.ru_maxrss*1024ULL;
+    #endif
+}
+#endif
+
 #if defined(__linux__)
 // process_mem_usage(double &, double &) - takes two doubles by reference,
 // attempts to read the system-dependent data for a process' virtual memory
@@ -0,0 +1,84 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#include "trace.h"
+#include <cstdio>
+#include <algorithm>
+
+Tracer::Tracer(size_t capacity) :
+    events(capacity == 0 ? 1 : capacity),
+    next(0),
+    epoch(std::chrono::steady_clock::now())
+{
+}
+
+uint32_t Tracer::thread_id()
+{
+    static std::atomic<uint32_t> num_threads(0);
+    static thread_local uint32_t id = num_threads.fetch_add(1) + 1;
+    return id;
+}
+
+static void write_json_str(FILE* f, const char* s)
+{
+    fputc('"', f);
+    for(; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+bool Tracer::write_json(const std::string& fname) const
+{
+    FILE* f = fopen(fname.c_str(), "w");
+    if (!f) return false;
+
+    const uint64_t total = next.load();
+    const uint64_t num = std::min<uint64_t>(total, events.size());
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f,
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+        "\"args\":{\"name\":\"gismo\"}}");
+    for(uint64_t i = total - num; i < total; i++) {
+        const Slot& slot = events[i % events.size()];
+        slot.lock();
+        const Event e = slot.ev;
+        slot.unlock();
+        if (e.name == NULL) continue;
+        fprintf(f, ",\n{\"name\":");
+        write_json_str(f, e.name);
+        fprintf(f, ",\"cat\":");
+        write_json_str(f, e.cat);
+        fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%llu",
+            e.tid, (unsigned long long)e.start, (unsigned long long)e.dur);
+        if (e.arg != -1) fprintf(f, ",\"args\":{\"v\":%lld}", (long long)e.arg);
+        fprintf(f, "}");
+    }
+    fprintf(f, "\n],\"otherData\":{\"spans_recorded\":%llu,\"spans_dropped\":%llu}}\n",
+        (unsigned long long)total, (unsigned long long)(total - num));
+    return fclose(f) == 0;
+}
@@ -0,0 +1,129 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+#ifndef ARJUN_TRACE_H
+#define ARJUN_TRACE_H
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Collects timeline spans in a fixed-size ring, allocated once up front, and
+// writes them as Chrome Trace Event JSON (chrome://tracing, ui.perfetto.dev).
+// When the ring wraps, the oldest spans are overwritten. Names must be string
+// literals, only the pointer is stored. Recording is safe from several
+// threads, each thread shows up as its own track: once the ring wraps, two
+// threads may get the same slot, so every slot has a spin lock of its own,
+// and the span with the higher index wins.
+class Tracer
+{
+public:
+    explicit Tracer(size_t capacity = 1U << 16);
+
+    //Microseconds since the tracer was created
+    uint64_t now() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    //arg is shown in the span's arguments unless it's -1
+    void span(const char* name, const char* cat, uint64_t start, int64_t arg = -1)
+    {
+        const uint64_t end = now();
+        const uint64_t at = next.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = events[at % events.size()];
+        slot.lock();
+        Event& e = slot.ev;
+        if (e.name == NULL || e.at < at) {
+            e.at = at;
+            e.name = name;
+            e.cat = cat;
+            e.start = start;
+            e.dur = end - start;
+            e.tid = thread_id();
+            e.arg = arg;
+        }
+        slot.unlock();
+    }
+
+    bool write_json(const std::string& fname) const;
+    uint64_t num_recorded() const { return next.load(); }
+    static uint32_t thread_id();
+
+private:
+    struct Event {
+        uint64_t at = 0;
+        const char* name = NULL;
+        const char* cat = NULL;
+        uint64_t start = 0;
+        uint64_t dur = 0;
+        uint32_t tid = 0;
+        int64_t arg = -1;
+    };
+    struct Slot {
+        void lock() const
+        {
+            while(busy.exchange(true, std::memory_order_acquire)) {}
+        }
+        void unlock() const { busy.store(false, std::memory_order_release); }
+
+        mutable std::atomic<bool> busy{false};
+        Event ev;
+    };
+    std::vector<Slot> events;
+    std::atomic<uint64_t> next;
+    std::chrono::steady_clock::time_point epoch;
+};
+
+// Records a span from construction to destruction, does nothing without a
+// tracer
+class TraceSpan
+{
+public:
+    TraceSpan(Tracer* _tracer, const char* _name, const char* _cat) :
+        tracer(_tracer),
+        name(_name),
+        cat(_cat)
+    {
+        if (tracer) start = tracer->now();
+    }
+
+    ~TraceSpan()
+    {
+        if (tracer) tracer->span(name, cat, start);
+    }
+
+private:
+    Tracer* tracer;
+    const char* name;
+    const char* cat;
+    uint64_t start = 0;
+};
+
+#endif //ARJUN_TRACE_H
@@ -0,0 +1,254 @@
+/*
+ Arjun
+
+ Copyright (c) 2019, Mate Soos and Kuldeep S. Meel.
+               2022, Anna L.D. Latour.
+ All rights reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ */
+
+/* Separate gismo_solver handles must be usable from separate threads at the
+ * same time. Every thread runs its own handles over formulas with a known
+ * answer, reusing them through gismo_reset(), and on one of them races
+ * gismo_interrupt() from a second thread against gismo_run(). Exits with 0
+ * if every answer was right. */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "gismo_c.h"
+
+#define NUM_THREADS 8
+#define NUM_ROUNDS 20
+#define CHAIN_LEN 200
+
+typedef struct {
+    int32_t* lits;
+    size_t num;
+    size_t cap;
+} LitBuf;
+
+static void push(LitBuf* b, int32_t l)
+{
+    if (b->num == b->cap) {
+        b->cap = b->cap ? b->cap*2 : 64;
+        b->lits = (int32_t*)realloc(b->lits, b->cap*sizeof(int32_t));
+        if (b->lits == NULL) abort();
+    }
+    b->lits[b->num++] = l;
+}
+
+/* Clauses of v[0] ^ ... ^ v[n-1] = 0, one for every assignment of odd
+ * parity, which it forbids */
+static void add_xor(LitBuf* b, const int32_t* v, uint32_t n)
+{
+    uint32_t a, i;
+    for(a = 0; a < (1U << n); a++) {
+        uint32_t par = 0;
+        for(i = 0; i < n; i++) par ^= (a >> i) & 1;
+        if (!par) continue;
+        for(i = 0; i < n; i++) push(b, ((a >> i) & 1) ? -v[i] : v[i]);
+        push(b, 0);
+    }
+}
+
+static int check(int cond, const char* what, uint32_t thread, uint32_t round)
+{
+    if (!cond) fprintf(stderr, "FAILED: %s (thread %u, round %u)\n", what, thread, round);
+    return cond;
+}
+
+static size_t run_and_count(gismo_solver* s, int* ret)
+{
+    *ret = gismo_run(s, 0, 0, 0);
+    return gismo_result_size(s);
+}
+
+/* x3 <-> (x1 AND x2): the only independent support is {1, 2} */
+static int and_gate(gismo_solver* s, uint32_t t, uint32_t r)
+{
+    const int32_t cls[] = {-3, 1, 0, -3, 2, 0, 3, -1, -2, 0};
+    uint32_t res[3];
+    int ret;
+    size_t n;
+    gismo_new_vars(s, 3);
+    if (!check(gismo_add_clauses(s, cls, sizeof(cls)/sizeof(cls[0])) == GISMO_OK,
+        "and: add clauses", t, r)) return 0;
+    n = run_and_count(s, &ret);
+    if (!check(ret == GISMO_OK && n == 2, "and: result size", t, r)) return 0;
+    gismo_get_result(s, res, 3);
+    if (res[0] > res[1]) {
+        const uint32_t tmp = res[0];
+        res[0] = res[1];
+        res[1] = tmp;
+    }
+    return check(res[0] == 1 && res[1] == 2, "and: result", t, r);
+}
+
+/* x1 ^ ... ^ x5 = 0. Every minimal independent support of a set of XORs has
+ * as many variables as the dimension of its solutions, 4 here */
+static int xor5(gismo_solver* s, uint32_t t, uint32_t r)
+{
+    const int32_t v[] = {1, 2, 3, 4, 5};
+    LitBuf b = {NULL, 0, 0};
+    int ret;
+    size_t n;
+    gismo_new_vars(s, 5);
+    add_xor(&b, v, 5);
+    ret = gismo_add_clauses(s, b.lits, b.num);
+    free(b.lits);
+    if (!check(ret == GISMO_OK, "xor: add clauses", t, r)) return 0;
+    n = run_and_count(s, &ret);
+    return check(ret == GISMO_OK && n == 4, "xor: result size", t, r);
+}
+
+/* x3 = x1 and x4 = x2, with groups {1, 2} and {3, 4}. Either group defines
+ * the other, so the answer is one group. The group ids don't have to be
+ * small or consecutive */
+static int groups(gismo_solver* s, uint32_t t, uint32_t r)
+{
+    const int32_t cls[] = {-3, 1, 0, 3, -1, 0, -4, 2, 0, 4, -2, 0};
+    const uint32_t grp[] = {7, 7, 100000, 100000};
+    int ret;
+    size_t n;
+    gismo_new_vars(s, 4);
+    if (!check(gismo_add_clauses(s, cls, sizeof(cls)/sizeof(cls[0])) == GISMO_OK,
+        "groups: add clauses", t, r)) return 0;
+    if (!check(gismo_set_groups(s, grp, 4) == GISMO_OK, "groups: set", t, r)) return 0;
+    n = run_and_count(s, &ret);
+    return check(ret == GISMO_OK && n == 2, "groups: result size", t, r);
+}
+
+/* y_i = x_i ^ y_(i-1), with x_i = i and y_i = CHAIN_LEN+i. Big enough for
+ * the interrupt to land while it runs: the answer has CHAIN_LEN variables if
+ * it finished, and is still independent, so has at least as many, if not */
+static void add_chain(gismo_solver* s)
+{
+    LitBuf b = {NULL, 0, 0};
+    int32_t v[3];
+    uint32_t i;
+    gismo_new_vars(s, 2*CHAIN_LEN);
+    push(&b, -1);
+    push(&b, CHAIN_LEN+1);
+    push(&b, 0);
+    push(&b, 1);
+    push(&b, -(CHAIN_LEN+1));
+    push(&b, 0);
+    for(i = 2; i <= CHAIN_LEN; i++) {
+        v[0] = i;
+        v[1] = CHAIN_LEN+i;
+        v[2] = CHAIN_LEN+i-1;
+        add_xor(&b, v, 3);
+    }
+    gismo_add_clauses(s, b.lits, b.num);
+    free(b.lits);
+}
+
+typedef struct {
+    gismo_solver* s;
+    long delay_us;
+} Interrupter;
+
+static void* interrupter(void* arg)
+{
+    const Interrupter* in = (const Interrupter*)arg;
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = in->delay_us*1000;
+    nanosleep(&ts, NULL);
+    gismo_interrupt(in->s);
+    return NULL;
+}
+
+static int interrupted_chain(gismo_solver* s, uint32_t t, uint32_t r)
+{
+    Interrupter in;
+    pthread_t th;
+    int ret;
+    size_t n;
+    add_chain(s);
+    in.s = s;
+    in.delay_us = (long)((t*7919 + r*104729) % 3000);
+    if (pthread_create(&th, NULL, interrupter, &in) != 0) return 0;
+    n = run_and_count(s, &ret);
+    pthread_join(th, NULL);
+    if (!check(ret == GISMO_OK || ret == GISMO_STOPPED, "chain: return code", t, r)) return 0;
+    if (ret == GISMO_OK) return check(n == CHAIN_LEN, "chain: result size", t, r);
+    return check(n >= CHAIN_LEN && n <= 2*CHAIN_LEN, "chain: stopped result size", t, r);
+}
+
+typedef struct {
+    uint32_t id;
+    int ok;
+} Worker;
+
+static void* worker(void* arg)
+{
+    Worker* w = (Worker*)arg;
+    gismo_solver* s = gismo_new();
+    gismo_solver* racing = gismo_new();
+    uint32_t r;
+    w->ok = s != NULL && racing != NULL;
+    if (w->ok) {
+        gismo_set_seed(s, w->id);
+        gismo_set_seed(racing, w->id);
+    }
+    for(r = 0; r < NUM_ROUNDS && w->ok; r++) {
+        /* Rotate the formulas, so that every thread does something else */
+        switch((w->id + r) % 3) {
+            case 0: w->ok = and_gate(s, w->id, r); break;
+            case 1: w->ok = xor5(s, w->id, r); break;
+            case 2: w->ok = groups(s, w->id, r); break;
+        }
+        if (w->ok) w->ok = check(gismo_reset(s) == GISMO_OK, "reset", w->id, r);
+        if (w->ok) w->ok = interrupted_chain(racing, w->id, r);
+        if (w->ok) w->ok = check(gismo_reset(racing) == GISMO_OK, "reset", w->id, r);
+    }
+    gismo_free(s);
+    gismo_free(racing);
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t th[NUM_THREADS];
+    Worker w[NUM_THREADS];
+    uint32_t i;
+    int ok = 1;
+    for(i = 0; i < NUM_THREADS; i++) {
+        w[i].id = i;
+        w[i].ok = 0;
+        if (pthread_create(&th[i], NULL, worker, &w[i]) != 0) {
+            fprintf(stderr, "FAILED: could not start thread %u\n", i);
+            return 1;
+        }
+    }
+    for(i = 0; i < NUM_THREADS; i++) {
+        pthread_join(th[i], NULL);
+        ok &= w[i].ok;
+    }
+    printf("%s\n", ok ? "c_api_stress: ok" : "c_api_stress: FAILED");
+    return ok ? 0 : 1;
+}